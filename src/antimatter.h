@@ -1,6 +1,6 @@
 #pragma once
 
-#define ANIM_SPEED 0.0012f
+#define ANIM_SPEED 12
 #define BONUS_LIMIT 3600
 #define BUF_LEN 1024
 #define CHARS_PER_ROW 20
@@ -11,25 +11,36 @@
 #define FONT_OFFSET 328
 #define FONT_W 8
 #define FRAME_W 8
+#define KEYFRAME_TICKS 500
 #define MAP_H 11
 #define MAP_W 11
+#define MAX_DOOMED 8
 #define MAX_LEVEL 7
-#define MAX_SPRITES 122
+#define MAX_PENDING 4
+#define MAX_SPRITES 64
 #define MAX_LAG 800
+#define MAX_TICKS 8
 #define MAX_X 176
 #define MAX_Y 176
-#define MOVEMENT_SPEED 0.12f
+#define MOVEMENT_SCALE 100
+#define MOVEMENT_SPEED 12
 #define MS_PER_FRAME 20
+#define PHASE_ONE 10000
 #define SAMPLE_RATE 44100
 #define SAMPLES_PER_TICK 200
+#define SAVE_TICKS 50
 #define START_LEVEL 0
 #define START_LIVES 4
 #define SWAP_COST 400
 #define TEXTURE_H 184
 #define TEXTURE_W 160
+#define TICK_MS 20
 #define TILES_PER_ROW 10
 #define TILE_H 16
 #define TILE_W 16
+#define UNDO_DEPTH 4096
+#define UNDO_PIECES 8
+#define WALL_SLOT 255
 #define WALL_TILE_BASE 27
 #define WINDOW_H 192
 #define WINDOW_TITLE "ANTI/MATTER"
@@ -1,5 +1,6 @@
 #pragma once
 #include "antimatter.h"
+#include "replay.h"
 #include "sound.h"
 
 #ifdef WASM_BACKEND
@@ -10,23 +11,41 @@ typedef struct {
     size_t cap;
 } VertexBuf;
 
-typedef struct {
+typedef struct Backend {
     int stat;
     VertexBuf sprites;
     VertexBuf lines;
+    UndoLog* undo;
+} Backend;
+
+#elif defined(REPLAY_BACKEND)
+
+typedef struct Backend {
+    ReplayHeader hdr;
+    ReplayInput* inputs;
+    KeyframeRef* kf_index;
+    uint8_t* kf_data;
+    uint32_t pos;
+    UndoLog* undo;
 } Backend;
 
 #else
 
 #include <SDL.h>
 
-typedef struct {
+typedef struct Backend {
     SDL_Window* win;
     SDL_Renderer* ren;
     SDL_Texture* tex;
     SDL_Texture* stx;
     SDL_AudioDeviceID dev;
     SoundGen* snd;
+    FILE* hash_log;
+    char* save_path;
+    FILE* replay;
+    ReplayHeader rp_hdr;
+    KeyframeLog* keyframes;
+    UndoLog* undo;
 } Backend;
 
 #endif
@@ -47,10 +66,12 @@ typedef enum {
     KD_F5,
     KD_F6,
     KD_F10,
+    KD_F7,
+    KD_F8,
 } Event;
 
 Backend* be_init(void);
-Event be_get_event(Backend* be);
+Event be_get_event(Backend* be, uint32_t tick);
 void be_set_color(Backend* be, int color);
 void be_set_render_target(Backend* be, int tgt);
 void be_clear(Backend* be);
@@ -61,6 +82,16 @@ void be_blit_static(Backend* be);
 void be_draw_line(Backend* be, int x1, int y1, int x2, int y2);
 void be_fill_rect(Backend* be, int x, int y, int w, int h);
 void be_send_audiomsg(Backend* be, int msg);
+void be_record_hash(Backend* be, uint32_t tick, uint64_t hash);
+void be_save_state(Backend* be, const void* buf, size_t len);
+size_t be_load_state(Backend* be, void* buf, size_t cap);
+void be_save_keyframe(Backend* be, const SaveState* ss);
 double be_get_millis(void);
 void be_delay(int64_t dur);
 void be_quit(Backend* be);
+
+#ifdef REPLAY_BACKEND
+Backend* be_open_replay(const char* path);
+const Keyframe* be_find_keyframe(Backend* be, uint32_t tick);
+void be_seek_input(Backend* be, uint32_t tick);
+#endif
@@ -0,0 +1,408 @@
+#include <string.h>
+#include "bitboard.h"
+
+static const Mask BOARD = { 0xffffffffffffffffu, 0x1ffffffffffffffu };
+static const Mask COL0 = { 0x80100200400801u, 0x400801002004u };
+static const Mask COL10 = { 0x40080100200400u, 0x100200400801002u };
+static const Mask ROW0 = { 0x7ffu, 0 };
+
+static Mask m_or(Mask a, Mask b);
+static Mask m_and(Mask a, Mask b);
+static Mask m_andn(Mask a, Mask b);
+static bool m_any(Mask m);
+static Mask m_bit(int cell);
+static Mask m_range(int lo, int hi);
+static Mask m_shl(Mask m, int n);
+static Mask m_shr(Mask m, int n);
+static Mask m_shift(Mask m, Delta d);
+static int m_first(Mask m);
+static int m_count(Mask m);
+static Mask occupied(Board* bb);
+static Mask movable(Board* bb);
+static Mask polar(Board* bb);
+static bool tile_can_move(Board* bb, Mask front, Mask next);
+static bool tile_can_move_both(Board* bb, Delta d);
+static void push_pieces(Board* bb, Delta d);
+static Mask overlaps(Board* bb);
+static int32_t cross_gap(Board* bb, Delta d);
+static int32_t line_gap(Board* bb);
+static Mask can_leave(Mask free, Delta d);
+
+void bb_load(Board* bb, GameState* gs) {
+    *bb = (Board) { .energy = gs->energy, .to_clear = gs->to_clear };
+
+    for (int i = 0; i < MAP_W * MAP_H; i++) {
+        if (gs->walls[i]) {
+            bb->pcs[BB_WALL] = m_or(bb->pcs[BB_WALL], m_bit(i));
+        }
+    }
+
+    for (uint32_t i = 1; i < gs->n_sprites; i++) {
+        Sprite* s = &gs->sprites[i];
+
+        if (has_flag(s, F_NIL) || s->p.x < 0 || s->p.y < 0) {
+            continue;
+        }
+
+        PieceClass c = i == ID_ANTI ? BB_ANTI : i == ID_MATTER ? BB_MATTER :
+            (has_flag(s, F_UNSTABLE) ? BB_BOMB_B : BB_BLOB_B) + has_flag(s, F_POLARITY);
+        Mask m = m_bit(s->p.y / TILE_H * MAP_W + s->p.x / TILE_W);
+        bb->pcs[c] = m_or(bb->pcs[c], m);
+    }
+}
+
+uint8_t bb_moves(Board* bb) {
+    uint8_t moves = 0;
+
+    for (uint8_t i = 0; i < 4; i++) {
+        moves |= (uint8_t) (tile_can_move_both(bb, BB_DIRS[i]) << i);
+    }
+
+    return moves;
+}
+
+bool bb_move(Board* bb, Delta d, GameEvent* ev) {
+    if (!tile_can_move_both(bb, d)) {
+        return false;
+    }
+
+    int32_t gap = cross_gap(bb, d);
+    push_pieces(bb, d);
+
+    if (gap >= 0) {
+        bb->energy -= TILE_W / 2 + gap / 2;
+    } else {
+        bb->energy -= TILE_W;
+        gap = line_gap(bb);
+        bb->energy -= gap > 0 ? gap / 2 : 0;
+    }
+
+    Mask dup = overlaps(bb);
+    Mask unstable = m_or(m_or(bb->pcs[BB_BOMB_B], bb->pcs[BB_BOMB_R]),
+            m_or(bb->pcs[BB_ANTI], bb->pcs[BB_MATTER]));
+
+    if (bb->energy < 1) {
+        *ev = GE_EXHAUSTED;
+    } else if (gap >= 0 || m_any(m_and(dup, unstable))) {
+        *ev = GE_EXPLODE;
+    } else if (m_any(dup)) {
+        bb->pcs[BB_BLOB_B] = m_andn(bb->pcs[BB_BLOB_B], dup);
+        bb->pcs[BB_BLOB_R] = m_andn(bb->pcs[BB_BLOB_R], dup);
+        bb->to_clear -= 2 * m_count(dup);
+        *ev = bb->to_clear <= 0 ? GE_CLEAR : GE_DESTROY;
+    } else {
+        *ev = GE_MOVE;
+    }
+
+    return true;
+}
+
+bool bb_los(Board* bb) {
+    return line_gap(bb) >= 0;
+}
+
+void bb_deadlocks(Deadlocks* dl, Board* bb) {
+    Mask free = m_andn(BOARD, bb->pcs[BB_WALL]);
+    Mask leave[4];
+    Mask any = { 0, 0 };
+
+    for (int i = 0; i < 4; i++) {
+        leave[i] = can_leave(free, BB_DIRS[i]);
+        any = m_or(any, leave[i]);
+    }
+
+    dl->stuck = m_andn(free, any);
+
+    for (int cell = 0; cell < MAP_W * MAP_H; cell++) {
+        Mask reach = m_and(m_bit(cell), free);
+        Mask prev;
+
+        do {
+            prev = reach;
+
+            for (int i = 0; i < 4; i++) {
+                reach = m_or(reach, m_shift(m_and(reach, leave[i]), BB_DIRS[i]));
+            }
+        } while (reach.lo != prev.lo || reach.hi != prev.hi);
+
+        dl->reach[cell] = reach;
+    }
+}
+
+bool bb_deadlocked(const Deadlocks* dl, Board* bb) {
+    Mask blue = bb->pcs[BB_BLOB_B];
+    Mask red = bb->pcs[BB_BLOB_R];
+    Mask blobs = m_or(blue, red);
+
+    while (m_any(blobs)) {
+        Mask region = dl->reach[m_first(blobs)];
+
+        if (m_count(m_and(blue, region)) != m_count(m_and(red, region))) {
+            return true;
+        }
+
+        blobs = m_andn(blobs, region);
+    }
+
+    return false;
+}
+
+void bb_pack_deadlocks(const Deadlocks* dl, uint8_t* regions) {
+    uint8_t n = 0;
+    memset(regions, 0, MAP_W * MAP_H);
+
+    for (int cell = 0; cell < MAP_W * MAP_H; cell++) {
+        if (regions[cell] != 0 || !m_any(dl->reach[cell])) {
+            continue;
+        }
+
+        n++;
+
+        for (Mask m = dl->reach[cell]; m_any(m); m = m_andn(m, m_bit(m_first(m)))) {
+            regions[m_first(m)] = n;
+        }
+    }
+}
+
+void bb_unpack_deadlocks(Deadlocks* dl, const uint8_t* regions) {
+    Mask masks[MAP_W * MAP_H + 1] = { { 0, 0 } };
+    uint8_t sizes[MAP_W * MAP_H + 1] = { 0 };
+    dl->stuck = (Mask) { 0, 0 };
+
+    for (int cell = 0; cell < MAP_W * MAP_H; cell++) {
+        masks[regions[cell]] = m_or(masks[regions[cell]], m_bit(cell));
+        sizes[regions[cell]]++;
+    }
+
+    for (int cell = 0; cell < MAP_W * MAP_H; cell++) {
+        uint8_t r = regions[cell];
+        dl->reach[cell] = r != 0 ? masks[r] : (Mask) { 0, 0 };
+        dl->stuck = r != 0 && sizes[r] == 1 ? m_or(dl->stuck, m_bit(cell)) : dl->stuck;
+    }
+}
+
+static Mask m_or(Mask a, Mask b) {
+    return (Mask) { a.lo | b.lo, a.hi | b.hi };
+}
+
+static Mask m_and(Mask a, Mask b) {
+    return (Mask) { a.lo & b.lo, a.hi & b.hi };
+}
+
+static Mask m_andn(Mask a, Mask b) {
+    return (Mask) { a.lo & ~b.lo, a.hi & ~b.hi };
+}
+
+static bool m_any(Mask m) {
+    return (m.lo | m.hi) != 0;
+}
+
+static Mask m_bit(int cell) {
+    return m_shl((Mask) { 1, 0 }, cell);
+}
+
+static Mask m_range(int lo, int hi) {
+    if (hi <= lo) {
+        return (Mask) { 0, 0 };
+    }
+
+    return m_shl(m_shr(BOARD, MAP_W * MAP_H - (hi - lo)), lo);
+}
+
+static Mask m_shl(Mask m, int n) {
+    if (n == 0) {
+        return m;
+    }
+
+    if (n >= 64) {
+        return m_and((Mask) { 0, m.lo << (n - 64) }, BOARD);
+    }
+
+    return m_and((Mask) { m.lo << n, m.hi << n | m.lo >> (64 - n) }, BOARD);
+}
+
+static Mask m_shr(Mask m, int n) {
+    if (n == 0) {
+        return m;
+    }
+
+    if (n >= 64) {
+        return (Mask) { m.hi >> (n - 64), 0 };
+    }
+
+    return (Mask) { m.lo >> n | m.hi << (64 - n), m.hi >> n };
+}
+
+static Mask m_shift(Mask m, Delta d) {
+    if (d.x > 0) {
+        return m_or(m_shl(m_andn(m, COL10), 1), m_shr(m_and(m, COL10), MAP_W - 1));
+    }
+
+    if (d.x < 0) {
+        return m_or(m_shr(m_andn(m, COL0), 1), m_shl(m_and(m, COL0), MAP_W - 1));
+    }
+
+    if (d.y > 0) {
+        return m_or(m_shl(m, MAP_W), m_shr(m, MAP_W * (MAP_H - 1)));
+    }
+
+    if (d.y < 0) {
+        return m_or(m_shr(m, MAP_W), m_shl(m_and(m, ROW0), MAP_W * (MAP_H - 1)));
+    }
+
+    return m;
+}
+
+static int m_first(Mask m) {
+    return m.lo ? __builtin_ctzll(m.lo) : 64 + __builtin_ctzll(m.hi);
+}
+
+static int m_count(Mask m) {
+    return __builtin_popcountll(m.lo) + __builtin_popcountll(m.hi);
+}
+
+static Mask occupied(Board* bb) {
+    Mask m = bb->pcs[0];
+
+    for (int i = 1; i < BB_CLASSES; i++) {
+        m = m_or(m, bb->pcs[i]);
+    }
+
+    return m;
+}
+
+static Mask movable(Board* bb) {
+    return m_or(m_or(bb->pcs[BB_BLOB_B], bb->pcs[BB_BLOB_R]),
+            m_or(bb->pcs[BB_BOMB_B], bb->pcs[BB_BOMB_R]));
+}
+
+static Mask polar(Board* bb) {
+    return m_or(m_or(bb->pcs[BB_BLOB_R], bb->pcs[BB_BOMB_R]), bb->pcs[BB_MATTER]);
+}
+
+static bool tile_can_move(Board* bb, Mask front, Mask next) {
+    Mask empty = m_andn(BOARD, occupied(bb));
+    Mask mov = movable(bb);
+    Mask pol = polar(bb);
+    return m_any(m_and(front, empty)) ||
+        (m_any(m_and(front, mov)) &&
+            (m_any(m_and(next, empty)) ||
+                (m_any(m_and(next, mov)) &&
+                    m_any(m_and(front, pol)) != m_any(m_and(next, pol)))));
+}
+
+static bool tile_can_move_both(Board* bb, Delta d) {
+    Delta b = invert_delta(d);
+    Mask occ = occupied(bb);
+    Mask empty = m_andn(BOARD, occ);
+    Mask pol = polar(bb);
+    Mask fa = m_shift(bb->pcs[BB_ANTI], b);
+    Mask na = m_shift(fa, b);
+    Mask fm = m_shift(bb->pcs[BB_MATTER], d);
+    Mask nm = m_shift(fm, d);
+    return (tile_can_move(bb, fa, na) && tile_can_move(bb, fm, nm)) &&
+        !m_any(m_and(m_and(fa, nm), occ)) &&
+            !m_any(m_and(m_and(fm, na), occ)) &&
+                (!m_any(m_and(na, nm)) ||
+                    (m_any(m_and(fa, pol)) != m_any(m_and(fm, pol)) ||
+                        (m_any(m_and(fa, empty)) ||
+                            m_any(m_and(fm, empty)))));
+}
+
+static void push_pieces(Board* bb, Delta d) {
+    Delta b = invert_delta(d);
+    Mask pol = polar(bb);
+    Mask anti = bb->pcs[BB_ANTI];
+    Mask matter = bb->pcs[BB_MATTER];
+    Mask fa = m_shift(anti, b);
+    Mask fm = m_shift(matter, d);
+    Mask ba = m_and(m_shift(anti, d), m_any(m_and(anti, pol)) ? m_andn(BOARD, pol) : pol);
+    Mask bm = m_and(m_shift(matter, b), m_any(m_and(matter, pol)) ? m_andn(BOARD, pol) : pol);
+
+    for (int c = BB_BLOB_B; c <= BB_BOMB_R; c++) {
+        Mask m = bb->pcs[c];
+        Mask to_b = m_and(m, m_or(fa, ba));
+        Mask to_d = m_and(m, m_or(fm, bm));
+        m = m_andn(m, m_or(to_b, to_d));
+        bb->pcs[c] = m_or(m, m_or(m_shift(to_b, b), m_shift(to_d, d)));
+    }
+
+    bb->pcs[BB_ANTI] = fa;
+    bb->pcs[BB_MATTER] = fm;
+}
+
+static Mask overlaps(Board* bb) {
+    Mask seen = bb->pcs[0];
+    Mask dup = { 0, 0 };
+
+    for (int i = 1; i < BB_CLASSES; i++) {
+        dup = m_or(dup, m_and(seen, bb->pcs[i]));
+        seen = m_or(seen, bb->pcs[i]);
+    }
+
+    return dup;
+}
+
+static int32_t cross_gap(Board* bb, Delta d) {
+    if (!m_any(bb->pcs[BB_ANTI]) || !m_any(bb->pcs[BB_MATTER])) {
+        return -1;
+    }
+
+    int a = m_first(bb->pcs[BB_ANTI]);
+    int m = m_first(bb->pcs[BB_MATTER]);
+    int ar = a / MAP_W, ac = a % MAP_W;
+    int mr = m / MAP_W, mc = m % MAP_W;
+    Mask span;
+    int n;
+
+    if (d.y != 0 && ar == mr + d.y && ac != mc) {
+        int lo = ac < mc ? ac : mc;
+        int hi = ac < mc ? mc : ac;
+        span = m_or(m_range(ar * MAP_W + lo + 1, ar * MAP_W + hi),
+                m_range(mr * MAP_W + lo + 1, mr * MAP_W + hi));
+        n = hi - lo;
+    } else if (d.x != 0 && ac == mc + d.x && ar != mr) {
+        int lo = ar < mr ? ar : mr;
+        int hi = ar < mr ? mr : ar;
+        span = m_and(m_range((lo + 1) * MAP_W, hi * MAP_W),
+                m_or(m_shl(COL0, ac), m_shl(COL0, mc)));
+        n = hi - lo;
+    } else {
+        return -1;
+    }
+
+    return m_any(m_and(span, occupied(bb))) ? -1 : n * TILE_W;
+}
+
+static int32_t line_gap(Board* bb) {
+    if (!m_any(bb->pcs[BB_ANTI]) || !m_any(bb->pcs[BB_MATTER])) {
+        return -1;
+    }
+
+    int a = m_first(bb->pcs[BB_ANTI]);
+    int m = m_first(bb->pcs[BB_MATTER]);
+    int lo = a < m ? a : m;
+    int hi = a < m ? m : a;
+    Mask span;
+    int n;
+
+    if (a / MAP_W == m / MAP_W) {
+        span = m_range(lo + 1, hi);
+        n = hi - lo;
+    } else if (a % MAP_W == m % MAP_W) {
+        span = m_and(m_range(lo + 1, hi), m_shl(COL0, a % MAP_W));
+        n = (hi - lo) / MAP_W;
+    } else {
+        return -1;
+    }
+
+    return m_any(m_and(span, occupied(bb))) ? -1 : n * TILE_W;
+}
+
+static Mask can_leave(Mask free, Delta d) {
+    Delta b = invert_delta(d);
+    Mask ahead = m_shift(free, b);
+    Mask behind = m_shift(free, d);
+    Mask beyond = m_shift(ahead, b);
+    return m_and(m_and(free, ahead), m_or(behind, beyond));
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "gamestate.h"
+
+typedef struct {
+    uint64_t lo;
+    uint64_t hi;
+} Mask;
+
+typedef enum {
+    BB_WALL,
+    BB_BLOB_B,
+    BB_BLOB_R,
+    BB_BOMB_B,
+    BB_BOMB_R,
+    BB_ANTI,
+    BB_MATTER,
+    BB_CLASSES,
+} PieceClass;
+
+typedef struct {
+    Mask pcs[BB_CLASSES];
+    int32_t energy;
+    int32_t to_clear;
+} Board;
+
+typedef struct {
+    Mask stuck;
+    Mask reach[MAP_W * MAP_H];
+} Deadlocks;
+
+static const Delta BB_DIRS[4] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+
+void bb_load(Board* bb, GameState* gs);
+uint8_t bb_moves(Board* bb);
+bool bb_move(Board* bb, Delta d, GameEvent* ev);
+bool bb_los(Board* bb);
+void bb_deadlocks(Deadlocks* dl, Board* bb);
+bool bb_deadlocked(const Deadlocks* dl, Board* bb);
+void bb_pack_deadlocks(const Deadlocks* dl, uint8_t* regions);
+void bb_unpack_deadlocks(Deadlocks* dl, const uint8_t* regions);
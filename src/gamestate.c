@@ -1,79 +1,144 @@
-#include <math.h>
 #include <assert.h>
-#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "gamestate.h"
 #include "level_data.h"
-#include "scene.h"
+#ifndef LEVEL_BAKER
+#include "level_state.h"
+#endif
 
-static bool advance_clock(GameState* self, double timestamp);
+static void emit(EventSink* sink, GameState* gs, GameEvent ev);
+static void reset_level(GameState* gs);
 static void add_sprite(GameState* gs, int16_t x, int16_t y, uint8_t id);
 static void set_sprite_pos(GameState* gs, int16_t x, int16_t y, uint8_t id);
 static void add_wall(GameState* gs, int16_t x, int16_t y, uint8_t tile);
-static bool check_overlap(GameState* gs, Backend* be, Sprite* s1, Sprite* s2);
+static bool check_overlap(GameState* gs, EventSink* sink, Sprite* s1, Sprite* s2);
 static bool check_los(GameState* gs, Sprite* s1, Sprite* s2);
-static void render_stats(GameState* gs, Backend* be);
+static bool los_blocked(GameState* gs, Point p1, Point p2);
 static void remove_destroyed(GameState* gs);
+static void destroy(GameState* gs, Sprite* s);
+static void compact_sprites(GameState* gs);
+static void remap_adjacent(Adjacent* adj, uint8_t* map);
 static Adjacent find_adjacent(GameState* gs, Sprite* s, Delta d);
+static bool can_move_both(GameState* gs, Adjacent* a, Adjacent* b);
+static bool is_identical(GameState* gs, uint8_t s1, uint8_t s2);
+static bool start_move(GameState* gs, EventSink* sink, Delta forward);
+static void move_pending(GameState* gs, EventSink* sink);
+static void step_sprite(GameState* gs, uint8_t id, int8_t n, void (*advance)(Sprite*, int8_t));
+static void step_all(GameState* gs, int8_t n);
+static void step_kernel(GameState* gs, int8_t n, void (*advance)(Sprite*, int8_t));
+static bool level_wraps(GameState* gs);
+static Point neighbour(GameState* gs, Point p, Delta d);
+static bool is_settled(GameState* gs);
+static int16_t horizon(Sprite* s);
+static int8_t quiet_steps(GameState* gs, uint32_t limit);
+static int16_t quiet_los(GameState* gs, Delta va, Delta vm, int16_t n);
+static int16_t meet_step(int16_t a, int8_t va, int16_t b, int8_t vb);
+static bool has_blocker(GameState* gs, Delta va, Delta vm, int16_t n);
+static uint32_t between_sig(Point s, Point p1, Point p2);
+static Point point_at(Point p, Delta v, int16_t t);
+static void los_band(Point p1, Point p2, int* c0, int* c1, int* r0, int* r1);
+static int grid_cell(Point p);
+static void grid_link(GameState* gs, uint8_t id);
+static void grid_unlink(GameState* gs, uint8_t id, Point p);
+static void grid_move(GameState* gs, uint8_t id, Point from);
+static uint8_t grid_find(GameState* gs, Point p);
+static Point cell_point(int cell);
+static uint64_t hash_mix(uint64_t h, uint32_t w);
 
 GameState* gs_init(double start_t) {
     GameState* gs = calloc(1, sizeof(GameState));
     LOG_ERR(gs == NULL, "alloc failure")
+    gs->clock = (int64_t) start_t;
     gs->prev = (int64_t) start_t;
-    gs->spd_mod = -8.0f;
+    gs->spd_mod = -8;
     gs->high = 1000;
     gs->los = false;
+    gs->wall = (Sprite) { { -1, -1 }, { 0, 0 }, 0, 0 };
     add_sprite(gs, -1, -1, ID_NIL);
-    gs_set_scene(gs, sc_splash, 5); 
     return gs;
 }
 
-float gs_phase(GameState* self) {
+int32_t gs_phase(GameState* self) {
     if (self->delay == 0) {
         return self->phase;
     }
 
     if (self->prev < (self->start + self->delay)) {
-        return (float) (self->prev - self->start) / (float) self->delay;
+        return (int32_t) ((self->prev - self->start) * PHASE_ONE / self->delay);
     }
 
-    return 1.0f;
+    return PHASE_ONE;
 }
 
-bool gs_update(GameState* gs, Backend* be, double timestamp) {
-    if (advance_clock(gs, timestamp)) {
-        be_clear(be);
-        SceneFn* scene = gs->scene;
-        bool retval = scene(gs, be);
-        be_present(be);
-        return retval;
-    }
+uint32_t gs_advance_clock(GameState* self, double timestamp) {
+    int64_t now = (int64_t) timestamp;
+    int64_t lag = now - self->clock;
+    self->clock = now;
 
-    return true;
-}
+    if (!self->fixed) {
+        if (lag > 0 && lag < MAX_LAG) {
+            self->lag = lag;
+            return 1;
+        }
 
-void gs_limit_fps(GameState* self) {
-    int64_t next = self->prev + MS_PER_FRAME;
-    int64_t now = (int64_t) be_get_millis();
+        return 0;
+    }
 
-    if (next > now) {
-        be_delay(next - now);
+    if (lag > 0) {
+        self->acc += lag;
     }
+
+    uint32_t ticks = (uint32_t) (self->acc / TICK_MS);
+    self->acc %= TICK_MS;
+    self->lag = TICK_MS;
+    return ticks < MAX_TICKS ? ticks : MAX_TICKS;
 }
 
-void gs_set_scene(GameState* gs, SceneFn* scene, uint32_t delay) {
+void gs_tick(GameState* self) {
+    self->tick++;
+    self->prev = self->fixed ? self->prev + TICK_MS : self->clock;
+    self->phase = (int32_t) ((self->phase + ANIM_SPEED * self->lag) % PHASE_ONE);
+}
+
+void gs_set_scene(GameState* gs, uint8_t scene, uint32_t delay) {
     gs->start = gs->prev;
     gs->delay = delay * 1000;
     gs->scene = scene;
 }
 
 void gs_load_level(GameState* gs) {
+#ifdef LEVEL_BAKER
+    gs_decode_level(gs);
+#else
+    const LevelState* ls = gs_level_state(gs->level);
+    reset_level(gs);
+    memcpy(gs->walls, ls->walls, sizeof(gs->walls));
+    memcpy(gs->grid, ls->grid, sizeof(gs->grid));
+    memcpy(gs->grid_next, ls->grid_next, sizeof(gs->grid_next));
+    memcpy(&gs->sprites[ID_ANTI], &ls->sprites[ID_ANTI], (ls->n_sprites - 1) * sizeof(Sprite));
+    gs->n_sprites = ls->n_sprites;
+    gs->to_clear = ls->to_clear;
+    gs->wraps = ls->wraps;
+#endif
+}
+
+const LevelState* gs_level_state(int32_t level) {
+#ifdef LEVEL_BAKER
+    (void) level;
+    return NULL;
+#else
+    return &LEVEL_STATE[level];
+#endif
+}
+
+void gs_decode_level(GameState* gs) {
+    memset(gs->grid, ID_NIL, sizeof(gs->grid));
+    memset(gs->grid_next, ID_NIL, sizeof(gs->grid_next));
+    memset(gs->walls, 0, sizeof(gs->walls));
+    reset_level(gs);
     gs->n_sprites = 1;
     gs->to_clear = 0;
-    gs->los = false;
-    gs->energy = LEVEL_ENERGY[gs->level];
-    Sprite* nil = &gs->sprites[ID_NIL];
-    gs->adj_a = (Adjacent) { nil, nil, nil, { 0, 0 } };
-    gs->adj_m = (Adjacent) { nil, nil, nil, { -1, -1 } };
     add_sprite(gs, 160, 160, ID_ANTI);
     add_sprite(gs, 0, 0, ID_MATTER);
 
@@ -105,28 +170,28 @@ void gs_load_level(GameState* gs) {
                 }
         }
     }
+
+    gs->wraps = level_wraps(gs);
 }
 
 void gs_adv_state(GameState* gs) {
-    uint32_t moves = gs->lag * MOVEMENT_SPEED;
+    uint32_t moves = (uint32_t) (gs->lag * MOVEMENT_SPEED / MOVEMENT_SCALE);
     Sprite* anti = &gs->sprites[ID_ANTI];
     Sprite* matter = &gs->sprites[ID_MATTER];
 
-    for (size_t t = 0; t < moves; t++) {
-        if (is_moving(anti)) {
-            update_sprite(anti);
-            update_sprite(matter);
-            gs->energy--;
-        }
-
-        for (size_t i = 3; i < gs->n_sprites; i++) {
-            Sprite* s = &gs->sprites[i];
+    while (moves > 0) {
+        int8_t n = quiet_steps(gs, moves);
 
-            if (is_moving(s)) {
-                update_sprite(s);
-            }
+        if (n > 0) {
+            step_all(gs, n);
+            gs->los = false;
+            moves -= (uint32_t) n;
+            continue;
         }
 
+        step_all(gs, 1);
+        moves--;
+
         bool prev_los = gs->los;
         gs->los = check_los(gs, anti, matter);
 
@@ -135,40 +200,44 @@ void gs_adv_state(GameState* gs) {
 
         if (is_overlapping(anti, matter))
             return; 
-    }
 
+        if (is_settled(gs))
+            return;
+    }
 }
 
-void gs_post_update(GameState* gs, Backend* be) {
+void gs_post_update(GameState* gs, EventSink* sink) {
     remove_destroyed(gs);
 
     Sprite* anti = &gs->sprites[ID_ANTI];
     Sprite* matter = &gs->sprites[ID_MATTER];
 
     if (gs->energy < 1) { 
-        destroy_sprite(anti);
-        destroy_sprite(matter);
-        gs_set_scene(gs, sc_death1, 2);
-        be_send_audiomsg(be, MSG_STOP);
-        be_send_audiomsg(be, MSG_PLAY | 6);
+        destroy(gs, anti);
+        destroy(gs, matter);
+        emit(sink, gs, GE_EXHAUSTED);
         return;
     } 
 
     bool lose = false;
 
-    lose |= check_overlap(gs, be, gs->adj_a.front, gs->adj_m.front);
-    lose |= check_overlap(gs, be, gs->adj_a.front, gs->adj_a.next);
-    lose |= check_overlap(gs, be, gs->adj_m.front, gs->adj_m.next);
+    Sprite* front_a = gs_sprite(gs, gs->adj_a.front);
+    Sprite* front_m = gs_sprite(gs, gs->adj_m.front);
+    lose |= check_overlap(gs, sink, front_a, front_m);
+    lose |= check_overlap(gs, sink, front_a, gs_sprite(gs, gs->adj_a.next));
+    lose |= check_overlap(gs, sink, front_m, gs_sprite(gs, gs->adj_m.next));
     lose |= gs->los;
 
     if (gs->to_clear <= 0 && !lose) {
-        gs_set_scene(gs, sc_level_clear, 0);
-        be_send_audiomsg(be, MSG_STOP);
-        be_send_audiomsg(be, MSG_REPEAT | MSG_PLAY | 10);
+        emit(sink, gs, GE_CLEAR);
+        return;
+    }
+
+    if (check_overlap(gs, sink, anti, matter) || lose || gs->n_doomed > 0) {
         return;
     }
 
-    check_overlap(gs, be, anti, matter);
+    move_pending(gs, sink);
 }
 
 void gs_swap_sprites(GameState* gs) {
@@ -177,80 +246,75 @@ void gs_swap_sprites(GameState* gs) {
     Point p1 = s1->p; 
     s1->p = s2->p; 
     s2->p = p1; 
+    grid_move(gs, ID_ANTI, p1);
+    grid_move(gs, ID_MATTER, s1->p);
 }
 
-void gs_move_pcs(GameState* gs, Backend* be, int8_t dx, int8_t dy) {
-    Sprite* anti = &gs->sprites[ID_ANTI];
-    Sprite* matter = &gs->sprites[ID_MATTER];
-    Delta forward = { dx, dy };
-    Delta backward = invert_delta(forward);
-
-    if (!is_moving(anti) && !is_moving(matter)) {
-        gs->adj_a = find_adjacent(gs, anti, backward);
-        gs->adj_m = find_adjacent(gs, matter, forward);
-
-        if (can_move_both(&gs->adj_a, &gs->adj_m)) {
-            move_sprite(anti, &gs->adj_a, backward);
-            move_sprite(matter, &gs->adj_m, forward);
-            be_send_audiomsg(be, MSG_PLAY | 5);
+void gs_move_pcs(GameState* gs, EventSink* sink, int8_t dx, int8_t dy) {
+    if (is_moving(&gs->sprites[ID_ANTI]) || is_moving(&gs->sprites[ID_MATTER])) {
+        if (gs->n_pending < MAX_PENDING) {
+            gs->pending[gs->n_pending++] = (Delta) { dx, dy };
         }
+
+        return;
     }
+
+    start_move(gs, sink, (Delta) { dx, dy });
 }
 
-void gs_render_default(GameState* gs, Backend* be) {
-    be_fill_rect(be, 184, 0, 72, 192); 
-    be_blit_static(be);
-    render_stats(gs, be);
+bool gs_start_move(GameState* gs, EventSink* sink, int8_t dx, int8_t dy) {
+    if (is_moving(&gs->sprites[ID_ANTI]) || is_moving(&gs->sprites[ID_MATTER])) {
+        return false;
+    }
+
+    return start_move(gs, sink, (Delta) { dx, dy });
 }
 
-void gs_render_help(GameState* gs, Backend* be) {
-    int x = 42;
-    int y = 28;
-    int m = 16;
+void gs_reindex(GameState* gs) {
+    memset(gs->grid, ID_NIL, sizeof(gs->grid));
 
-    if (gs->phase > 0.25f) {
-        be_blit_text(be, x + 31, y, "PAUSED");
+    for (uint8_t i = 1; i < gs->n_sprites; i++) {
+        grid_link(gs, i);
     }
-
-    be_blit_text(be, x, y + m * 1, "ESC     RESUME"); 
-    be_blit_text(be, x, y + m * 2, "F1     RESTART");
-    be_blit_text(be, x, y + m * 3, "F2        MUTE"); 
-    be_blit_text(be, x, y + m * 4, "F3       SCALE"); 
-    be_blit_text(be, x, y + m * 5, "F4     FULLSCR"); 
-    be_blit_text(be, x, y + m * 6, "F5       VOL -"); 
-    be_blit_text(be, x, y + m * 7, "F6       VOL +"); 
-    be_blit_text(be, x, y + m * 8, "F10       QUIT"); 
 }
 
-void gs_render_sprites(GameState* gs, Backend* be) {
-    int16_t bound_x = MAX_X - TILE_W;
-    int16_t bound_y = MAX_Y - TILE_H;
-    int16_t fw = FRAME_W;
+uint64_t gs_hash(GameState* gs) {
+    uint64_t h = hash_mix(0, gs->n_sprites);
+    h = hash_mix(h, (uint32_t) gs->energy);
+    h = hash_mix(h, (uint32_t) gs->score);
+    h = hash_mix(h, (uint32_t) gs->lives << 16 | (uint32_t) gs->level << 8 | gs->los);
 
-    for (size_t i = 1; i < gs->n_sprites; i++) {
+    for (uint32_t i = 1; i < gs->n_sprites; i++) {
         Sprite* s = &gs->sprites[i];
+        h = hash_mix(h, (uint16_t) s->p.x | (uint32_t) (uint16_t) s->p.y << 16);
+        h = hash_mix(h, (uint8_t) s->d.x | (uint32_t) (uint8_t) s->d.y << 8 | 
+                (uint32_t) s->flags << 16 | (uint32_t) s->tile << 24);
+    }
 
-        if (!has_flag(s, F_NIL)) {
-            int16_t x = s->p.x;
-            int16_t y = s->p.y;
-            int tile = s->tile;
-            float offset = gs->phase * gs->spd_mod;
-
-            if (has_flag(s, F_ANIMATED)) {
-                tile += (4 - (int) offset % 4) % 4;
-            } 
-
-            if (x > bound_x) {
-                int16_t x2 = x - MAX_X; 
-                be_blit_tile(be, x2 + fw, y + fw, tile);
-            } else if (y > bound_y) {
-                int16_t y2 = y - MAX_Y; 
-                be_blit_tile(be, x + fw, y2 + fw, tile);
-            }
+    return h;
+}
 
-            be_blit_tile(be, x + fw, y + fw, tile);
-        }
-    }
+Sprite* gs_sprite(GameState* gs, uint8_t slot) {
+    return slot == WALL_SLOT ? &gs->wall : &gs->sprites[slot];
+}
+
+void gs_put_sprite(GameState* gs, uint8_t slot, uint8_t id, Point p) {
+    assert(slot < gs->n_sprites);
+    Sprite* s = &gs->sprites[slot];
+    Point from = s->p;
+    *s = PROTOTYPES[id];
+    s->p = p;
+    grid_move(gs, slot, from);
+}
+
+void gs_insert_sprite(GameState* gs, uint8_t slot, uint8_t id, Point p) {
+    assert(gs->n_sprites < MAX_SPRITES && slot <= gs->n_sprites);
+    Sprite* s = &gs->sprites[slot];
+    memmove(s + 1, s, (gs->n_sprites - slot) * sizeof(Sprite));
+    *s = PROTOTYPES[id];
+    s->p = p;
+    gs->n_sprites++;
+    gs_reindex(gs);
 }
 
 void gs_quit(GameState* gs) {
@@ -265,19 +329,19 @@ void gs_score(GameState* gs, int32_t num) {
     }
 }
 
-static bool advance_clock(GameState* self, double timestamp) {
-    int64_t now = (int64_t) timestamp;
-    int64_t lag = now - self->prev;
-    self->prev = now;
-
-    if (lag > 0 && lag < MAX_LAG) {
-        float incr = ANIM_SPEED * (float) lag;
-        self->phase = fmodf(self->phase + incr, 1.0f);
-        self->lag = lag; 
-        return true;
+static void emit(EventSink* sink, GameState* gs, GameEvent ev) {
+    if (sink != NULL) {
+        sink->emit(sink->ctx, gs, ev);
     }
+}
 
-    return false;
+static void reset_level(GameState* gs) {
+    gs->n_doomed = 0;
+    gs->n_pending = 0;
+    gs->los = false;
+    gs->energy = LEVEL_ENERGY[gs->level];
+    gs->adj_a = (Adjacent) { ID_NIL, ID_NIL, ID_NIL, { 0, 0 } };
+    gs->adj_m = (Adjacent) { ID_NIL, ID_NIL, ID_NIL, { -1, -1 } };
 }
 
 static void add_sprite(GameState* gs, int16_t x, int16_t y, uint8_t id) {
@@ -285,38 +349,33 @@ static void add_sprite(GameState* gs, int16_t x, int16_t y, uint8_t id) {
     Sprite* s = &gs->sprites[gs->n_sprites];
     *s = PROTOTYPES[id];
     s->p = (Point) { x, y }; 
+    grid_link(gs, (uint8_t) gs->n_sprites);
     gs->n_sprites++;
 }
 
 static void set_sprite_pos(GameState* gs, int16_t x, int16_t y, uint8_t id) {
     assert(id < gs->n_sprites);
     Sprite* s = &gs->sprites[id];
+    Point from = s->p;
     s->p = (Point) { x, y }; 
+    grid_move(gs, id, from);
 }
 
 static void add_wall(GameState* gs, int16_t x, int16_t y, uint8_t tile) {
-    assert(gs->n_sprites < MAX_SPRITES);
-    Sprite* s = &gs->sprites[gs->n_sprites];
-    s->p = (Point) { x, y }; 
-    s->flags = 0; 
-    s->tile = tile; 
-    gs->n_sprites++;
+    gs->walls[grid_cell((Point) { x, y })] = tile;
 }
 
-static bool check_overlap(GameState* gs, Backend* be, Sprite* s1, Sprite* s2) {
+static bool check_overlap(GameState* gs, EventSink* sink, Sprite* s1, Sprite* s2) {
     if (is_overlapping(s1, s2)) {
         if (has_flag(s1, F_UNSTABLE) || has_flag(s2, F_UNSTABLE)) {
             s1->tile = 41;
             s2->tile = 41;
-            gs_set_scene(gs, sc_death2, 2);
-            be_send_audiomsg(be, MSG_STOP);
-            be_send_audiomsg(be, MSG_PLAY | 7);
+            emit(sink, gs, GE_EXPLODE);
             return true;
         } else {
-            gs_set_scene(gs, sc_wait, 1);
-            destroy_sprite(s1);
-            destroy_sprite(s2);
-            be_send_audiomsg(be, MSG_PLAY | 9);
+            destroy(gs, s1);
+            destroy(gs, s2);
+            emit(sink, gs, GE_DESTROY);
         }
     }
 
@@ -330,12 +389,8 @@ static bool check_los(GameState* gs, Sprite* s1, Sprite* s2) {
     Delta d = get_delta(s1, s2);
 
     if (d.x == 0 || d.y == 0) {
-        for (size_t i = 3; i < gs->n_sprites; i++) {
-            Sprite* s0 = &gs->sprites[i];
-
-            if (point_between(s0->p, s1->p, s2->p)) {
-                return false;
-            }
+        if (!point_equals(s1->p, s2->p) && los_blocked(gs, s1->p, s2->p)) {
+            return false;
         }
 
         s1->d = d;
@@ -346,99 +401,477 @@ static bool check_los(GameState* gs, Sprite* s1, Sprite* s2) {
     return false;
 }
 
+static bool los_blocked(GameState* gs, Point p1, Point p2) {
+    int c0, c1, r0, r1;
+    los_band(p1, p2, &c0, &c1, &r0, &r1);
+
+    for (int r = r0; r <= r1; r++) {
+        for (int c = c0; c <= c1; c++) {
+            int cell = r * MAP_W + c;
+
+            if (gs->walls[cell] && point_between(cell_point(cell), p1, p2)) {
+                return true;
+            }
+
+            for (uint8_t i = gs->grid[cell]; i != ID_NIL; i = gs->grid_next[i]) {
+                if (i >= 3 && point_between(gs->sprites[i].p, p1, p2)) {
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+static void los_band(Point p1, Point p2, int* c0, int* c1, int* r0, int* r1) {
+    bool vert = p1.x == p2.x;
+    int lo_x = vert ? p1.x - 8 : (p1.x < p2.x ? p1.x : p2.x);
+    int hi_x = vert ? p1.x + 8 : (p1.x > p2.x ? p1.x : p2.x);
+    int lo_y = vert ? (p1.y < p2.y ? p1.y : p2.y) : p1.y - 8;
+    int hi_y = vert ? (p1.y > p2.y ? p1.y : p2.y) : p1.y + 8;
+    *c0 = lo_x < 0 ? 0 : lo_x / TILE_W;
+    *c1 = hi_x / TILE_W < MAP_W ? hi_x / TILE_W : MAP_W - 1;
+    *r0 = lo_y < 0 ? 0 : lo_y / TILE_H;
+    *r1 = hi_y / TILE_H < MAP_H ? hi_y / TILE_H : MAP_H - 1;
+}
+
 static void remove_destroyed(GameState* gs) {
-    for (size_t i = 3; i < gs->n_sprites; i++) {
-        Sprite* s = &gs->sprites[i];
+    if (gs->n_doomed == 0) {
+        return;
+    }
+
+    for (size_t i = 0; i < gs->n_doomed; i++) {
+        Sprite* s = &gs->sprites[gs->doomed[i]];
 
         if (has_flag(s, F_DESTROY)) {
             gs->to_clear--;
             gs_score(gs, DESTROY_BONUS);
-            destroy_sprite(s);
+            destroy(gs, s);
         }
     }
+
+    gs->n_doomed = 0;
+    compact_sprites(gs);
+}
+
+static void compact_sprites(GameState* gs) {
+    uint8_t map[MAX_SPRITES] = { ID_NIL, ID_ANTI, ID_MATTER };
+    uint32_t n = 3;
+
+    for (uint32_t i = 3; i < gs->n_sprites; i++) {
+        if (has_flag(&gs->sprites[i], F_NIL)) {
+            map[i] = ID_NIL;
+        } else {
+            map[i] = (uint8_t) n;
+            gs->sprites[n++] = gs->sprites[i];
+        }
+    }
+
+    if (n == gs->n_sprites) {
+        return;
+    }
+
+    gs->n_sprites = n;
+    remap_adjacent(&gs->adj_a, map);
+    remap_adjacent(&gs->adj_m, map);
+    gs_reindex(gs);
+}
+
+static void remap_adjacent(Adjacent* adj, uint8_t* map) {
+    uint8_t* refs[3] = { &adj->front, &adj->back, &adj->next };
+
+    for (size_t i = 0; i < 3; i++) {
+        if (*refs[i] != WALL_SLOT) {
+            *refs[i] = map[*refs[i]];
+        }
+    }
+}
+
+static void destroy(GameState* gs, Sprite* s) {
+    uint8_t id = (uint8_t) (s - gs->sprites);
+    Point from = s->p;
+    destroy_sprite(s);
+    grid_move(gs, id, from);
+
+    if (id >= 3 && has_flag(s, F_DESTROY)) {
+        assert(gs->n_doomed < MAX_DOOMED);
+        gs->doomed[gs->n_doomed++] = id;
+    }
+}
+
+static bool start_move(GameState* gs, EventSink* sink, Delta forward) {
+    Sprite* anti = &gs->sprites[ID_ANTI];
+    Sprite* matter = &gs->sprites[ID_MATTER];
+    Delta backward = invert_delta(forward);
+    gs->adj_a = find_adjacent(gs, anti, backward);
+    gs->adj_m = find_adjacent(gs, matter, forward);
+
+    if (can_move_both(gs, &gs->adj_a, &gs->adj_m)) {
+        move_sprite(anti, gs_sprite(gs, gs->adj_a.front), gs_sprite(gs, gs->adj_a.back), backward);
+        move_sprite(matter, gs_sprite(gs, gs->adj_m.front), gs_sprite(gs, gs->adj_m.back), forward);
+        emit(sink, gs, GE_MOVE);
+        return true;
+    }
+
+    return false;
+}
+
+static void move_pending(GameState* gs, EventSink* sink) {
+    uint8_t i = 0;
+    bool moved = false;
+
+    while (i < gs->n_pending && !moved) {
+        moved = start_move(gs, sink, gs->pending[i++]);
+    }
+
+    gs->n_pending = (uint8_t) (gs->n_pending - i);
+    memmove(gs->pending, gs->pending + i, gs->n_pending * sizeof(Delta));
 }
 
 static Adjacent find_adjacent(GameState* gs, Sprite* s1, Delta d) {
-    Point front = calc_tile(s1->p, d);
-    Point back = calc_tile(s1->p, invert_delta(d));
-    Point next = calc_tile(front, d);
-    Sprite* nil = &gs->sprites[ID_NIL];
-    Adjacent adj = { nil, nil, nil, next };
-
-    for (size_t i = 1; i < gs->n_sprites; i++) {
-        Sprite* s2 = &gs->sprites[i];
-
-        if (point_equals(s2->p, front)) {
-            adj.front = s2;
-        } else if (point_equals(s2->p, back)) {
-            adj.back = s2;
-        } else if (point_equals(s2->p, next)) {
-            adj.next = s2;
+    Point front = neighbour(gs, s1->p, d);
+    Point back = neighbour(gs, s1->p, invert_delta(d));
+    Point next = neighbour(gs, front, d);
+    return (Adjacent) { 
+        grid_find(gs, front), 
+        grid_find(gs, back), 
+        grid_find(gs, next), 
+        next,
+    };
+}
+
+static bool can_move_both(GameState* gs, Adjacent* a, Adjacent* b) {
+    Sprite* front_a = gs_sprite(gs, a->front);
+    Sprite* front_b = gs_sprite(gs, b->front);
+    return (can_move(front_a, gs_sprite(gs, a->next)) && can_move(front_b, gs_sprite(gs, b->next))) &&
+            !is_identical(gs, a->front, b->next) && 
+                !is_identical(gs, b->front, a->next) && 
+                    (!point_equals(a->next_p, b->next_p) || 
+                        (opp_polarity(front_a, front_b) ||
+                            (has_flag(front_a, F_NIL) ||
+                                has_flag(front_b, F_NIL))));
+}
+
+static bool is_identical(GameState* gs, uint8_t s1, uint8_t s2) {
+    return s1 == s2 && !has_flag(gs_sprite(gs, s1), F_NIL);
+}
+
+static Point neighbour(GameState* gs, Point p, Delta d) {
+    Point n = point_at(p, d, TILE_W);
+
+    if (gs->wraps || n.x < 0 || n.x >= MAX_X || n.y < 0 || n.y >= MAX_Y) {
+        return calc_tile(p, d);
+    }
+
+    return n;
+}
+
+static void step_sprite(GameState* gs, uint8_t id, int8_t n, void (*advance)(Sprite*, int8_t)) {
+    Sprite* s = &gs->sprites[id];
+    Point from = s->p;
+    advance(s, n);
+    grid_move(gs, id, from);
+}
+
+static void step_all(GameState* gs, int8_t n) {
+    if (gs->wraps) {
+        step_kernel(gs, n, advance_sprite);
+    } else {
+        step_kernel(gs, n, advance_sprite_nowrap);
+    }
+}
+
+static void step_kernel(GameState* gs, int8_t n, void (*advance)(Sprite*, int8_t)) {
+    if (is_moving(&gs->sprites[ID_ANTI])) {
+        step_sprite(gs, ID_ANTI, n, advance);
+        step_sprite(gs, ID_MATTER, n, advance);
+        gs->energy -= n;
+    }
+
+    for (size_t i = 3; i < gs->n_sprites; i++) {
+        if (is_moving(&gs->sprites[i])) {
+            step_sprite(gs, (uint8_t) i, n, advance);
+        }
+    }
+}
+
+static bool level_wraps(GameState* gs) {
+    uint8_t seen[MAP_W * MAP_H] = { 0 };
+    uint8_t stack[MAP_W * MAP_H];
+    size_t n = 0;
+
+    for (uint32_t i = 1; i < gs->n_sprites; i++) {
+        int cell = grid_cell(gs->sprites[i].p);
+
+        if (cell >= 0 && !seen[cell]) {
+            seen[cell] = 1;
+            stack[n++] = (uint8_t) cell;
         }
     }
 
-    return adj;
+    while (n > 0) {
+        int cell = stack[--n];
+        int r = cell / MAP_W;
+        int c = cell % MAP_W;
+        int edge[4] = { c == MAP_W - 1, c == 0, r == MAP_H - 1, r == 0 };
+        int adj[4] = { 
+            r * MAP_W + (c + 1) % MAP_W, 
+            r * MAP_W + (c + MAP_W - 1) % MAP_W,
+            (r + 1) % MAP_H * MAP_W + c,
+            (r + MAP_H - 1) % MAP_H * MAP_W + c,
+        };
+
+        for (size_t i = 0; i < 4; i++) {
+            if (gs->walls[adj[i]]) {
+                continue;
+            }
+
+            if (edge[i]) {
+                return true;
+            }
+
+            if (!seen[adj[i]]) {
+                seen[adj[i]] = 1;
+                stack[n++] = (uint8_t) adj[i];
+            }
+        }
+    }
+
+    return false;
 }
 
-void gs_decorate(Backend* be) {
-    uint8_t t = DECOR_TILE_BASE;
+static bool is_settled(GameState* gs) {
+    if (is_moving(&gs->sprites[ID_ANTI])) {
+        return false;
+    }
 
-    be_blit_tile(be, 0, 0, t);
-    for (int n = 16; n < 176; n += 16) {
-        be_blit_tile(be, n, 0, t + 4);
+    for (size_t i = 3; i < gs->n_sprites; i++) {
+        if (is_moving(&gs->sprites[i])) {
+            return false;
+        }
     }
-    be_blit_tile(be, 176, 0, t + 1);
 
-    for (int n = 16; n < 176; n += 16) {
-        be_blit_tile(be, 0, n, t + 7);
-    }     
-    be_blit_tile(be, 0, 176, t + 3);
+    return true;
+}
 
-    for (int n = 16; n < 176; n += 16) {
-        be_blit_tile(be, n, 176, t + 6);
+static int16_t horizon(Sprite* s) {
+    int16_t n = steps_to_stop(s);
+    int16_t edge_x = s->d.x > 0 ? MAX_X - 1 - s->p.x : s->p.x;
+    int16_t edge_y = s->d.y > 0 ? MAX_Y - 1 - s->p.y : s->p.y;
+
+    if (s->d.x != 0 && edge_x < n) {
+        n = edge_x;
     }
-    be_blit_tile(be, 176, 176, t + 2);
 
-    for (int n = 16; n < 176; n += 16) {
-        be_blit_tile(be, 176, n, t + 5);
+    if (s->d.y != 0 && edge_y < n) {
+        n = edge_y;
+    }
+
+    return n;
+}
+
+static int8_t quiet_steps(GameState* gs, uint32_t limit) {
+    Sprite* anti = &gs->sprites[ID_ANTI];
+    Sprite* matter = &gs->sprites[ID_MATTER];
+    Delta va = { 0, 0 };
+    Delta vm = { 0, 0 };
+    int16_t n = limit < TILE_W ? (int16_t) limit : TILE_W;
+    bool settled = true;
+
+    if (is_moving(anti)) {
+        va = anti->d;
+        vm = matter->d;
+        int16_t ha = horizon(anti);
+        int16_t hm = horizon(matter);
+        n = ha < n ? ha : n;
+        n = hm < n ? hm : n;
+        settled = false;
     }
-    for (int y = 27; y < 183; y += 26) {
-        be_blit_tile(be, 176, y, t + 8);
 
-        for (int x = 192; x < 240; x += 16) {
-            be_blit_tile(be, x, y, t + 4);
+    for (size_t i = 3; i < gs->n_sprites && n > 0; i++) {
+        Sprite* s = &gs->sprites[i];
+
+        if (is_moving(s)) {
+            int16_t h = horizon(s);
+            n = h < n ? h : n;
+            settled = false;
         }
+    }
 
-        be_blit_tile(be, 240, y, t + 9);
+    if (settled || n <= 0) {
+        return 0;
     }
 
-    be_blit_tile(be, 204, 5, 80);
-    be_blit_tile(be, 220, 5, 81);
-    be_blit_tile(be, 236, 5, 82);
+    return (int8_t) quiet_los(gs, va, vm, n);
+}
 
-    be_blit_tile(be, 197, 170, 83);
-    be_blit_tile(be, 197 + 16, 170, 84);
-    be_blit_tile(be, 197 + 32, 170, 85);
-    be_blit_tile(be, 197 + 48, 170, 86);
+static int16_t quiet_los(GameState* gs, Delta va, Delta vm, int16_t n) {
+    Point a = gs->sprites[ID_ANTI].p;
+    Point m = gs->sprites[ID_MATTER].p;
+    bool col_x = va.x == vm.x && a.x == m.x;
+    bool col_y = va.y == vm.y && a.y == m.y;
+    int16_t tx = col_x ? 1 : meet_step(a.x, va.x, m.x, vm.x);
+    int16_t ty = col_y ? 1 : meet_step(a.y, va.y, m.y, vm.y);
+    int16_t t_col = tx < ty ? tx : ty;
+    int16_t t_hit = col_x ? ty : (col_y ? tx : (tx == ty ? tx : INT16_MAX));
+
+    if (t_col > n) {
+        return n;
+    }
 
-    be_blit_text(be, 196, 36, "LEVEL");
-    be_blit_text(be, 196, 62, "HIGH");
-    be_blit_text(be, 196, 88, "SCORE"); 
-    be_blit_text(be, 196, 114, "ENERGY"); 
-    be_blit_text(be, 196, 140, "LIVES"); 
+    if (t_col > 1 || !(col_x || col_y)) {
+        return t_col - 1;
+    }
+
+    n = t_hit - 1 < n ? t_hit - 1 : n;
+
+    if (n <= 0) {
+        return 0;
+    }
+
+    Point a1 = point_at(a, va, 1);
+    Point an = point_at(a, va, n);
+
+    if ((a1.x > 160 && an.x > 160) || (a1.y > 160 && an.y > 160)) {
+        return n;
+    }
+
+    return has_blocker(gs, va, vm, n) ? n : 0;
+}
+
+static int16_t meet_step(int16_t a, int8_t va, int16_t b, int8_t vb) {
+    int16_t rel = va - vb;
+    int16_t gap = b - a;
+
+    if (rel == 0 || gap % rel != 0 || gap / rel < 1) {
+        return INT16_MAX;
+    }
+
+    return gap / rel;
+}
+
+static bool has_blocker(GameState* gs, Delta va, Delta vm, int16_t n) {
+    Point a = gs->sprites[ID_ANTI].p;
+    Point m = gs->sprites[ID_MATTER].p;
+    Point a1 = point_at(a, va, 1);
+    Point m1 = point_at(m, vm, 1);
+    Point an = point_at(a, va, n);
+    Point mn = point_at(m, vm, n);
+    int c0, c1, r0, r1;
+    los_band(a, m, &c0, &c1, &r0, &r1);
+
+    for (int r = r0; r <= r1; r++) {
+        for (int c = c0; c <= c1; c++) {
+            int cell = r * MAP_W + c;
+            Point w = cell_point(cell);
+
+            if (gs->walls[cell] && point_between(w, a1, m1) && 
+                    between_sig(w, a1, m1) == between_sig(w, an, mn)) {
+                return true;
+            }
+
+            for (uint8_t i = gs->grid[cell]; i != ID_NIL; i = gs->grid_next[i]) {
+                Sprite* s = &gs->sprites[i];
+                Point s1 = point_at(s->p, s->d, 1);
+                Point sn = point_at(s->p, s->d, n);
+
+                if (i >= 3 && point_between(s1, a1, m1) && 
+                        between_sig(s1, a1, m1) == between_sig(sn, an, mn)) {
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+static uint32_t between_sig(Point s, Point p1, Point p2) {
+    return (uint32_t) (s.x >= p1.x - 8) << 0
+        | (uint32_t) (s.x <= p1.x + 8) << 1
+        | (uint32_t) (s.y >= p1.y - 8) << 2
+        | (uint32_t) (s.y <= p1.y + 8) << 3
+        | (uint32_t) (p1.x < p2.x) << 4
+        | (uint32_t) (p2.x < p1.x) << 5
+        | (uint32_t) (s.x >= p1.x) << 6
+        | (uint32_t) (s.x <= p1.x) << 7
+        | (uint32_t) (s.x >= p2.x) << 8
+        | (uint32_t) (s.x <= p2.x) << 9
+        | (uint32_t) (p1.y < p2.y) << 10
+        | (uint32_t) (p2.y < p1.y) << 11
+        | (uint32_t) (s.y >= p1.y) << 12
+        | (uint32_t) (s.y <= p1.y) << 13
+        | (uint32_t) (s.y >= p2.y) << 14
+        | (uint32_t) (s.y <= p2.y) << 15;
+}
+
+static Point point_at(Point p, Delta v, int16_t t) {
+    return (Point) { (int16_t) (p.x + v.x * t), (int16_t) (p.y + v.y * t) };
 }
 
-static void render_stats(GameState* gs, Backend* be) {
-    static char level[8], high[8], score[8], energy[8], lives[8];
-    snprintf(level, 8, "%7d", gs->level);
-    snprintf(high, 8, "%7d", gs->high);
-    snprintf(score, 8, "%7d", gs->score);
-    snprintf(energy, 8, "%7d", gs->energy);
-    snprintf(lives, 8, "%7d", gs->lives);
-    be_blit_text(be, 196, 45, level); 
-    be_blit_text(be, 196, 71, high); 
-    be_blit_text(be, 196, 97, score); 
-    be_blit_text(be, 196, 123, energy); 
-    be_blit_text(be, 196, 149, lives); 
+static int grid_cell(Point p) {
+    if (p.x < 0 || p.y < 0) {
+        return -1;
+    }
+
+    return p.y / TILE_H * MAP_W + p.x / TILE_W;
+}
+
+static void grid_link(GameState* gs, uint8_t id) {
+    int cell = grid_cell(gs->sprites[id].p);
+
+    if (cell >= 0) {
+        gs->grid_next[id] = gs->grid[cell];
+        gs->grid[cell] = id;
+    }
+}
+
+static void grid_unlink(GameState* gs, uint8_t id, Point p) {
+    int cell = grid_cell(p);
+
+    if (cell >= 0) {
+        uint8_t* link = &gs->grid[cell];
+
+        while (*link != ID_NIL && *link != id) {
+            link = &gs->grid_next[*link];
+        }
+
+        if (*link == id) {
+            *link = gs->grid_next[id];
+        }
+    }
 }
 
+static void grid_move(GameState* gs, uint8_t id, Point from) {
+    if (grid_cell(from) != grid_cell(gs->sprites[id].p)) {
+        grid_unlink(gs, id, from);
+        grid_link(gs, id);
+    }
+}
+
+static uint8_t grid_find(GameState* gs, Point p) {
+    int cell = grid_cell(p);
+    uint8_t found = ID_NIL;
+
+    for (uint8_t i = gs->grid[cell]; i != ID_NIL; i = gs->grid_next[i]) {
+        if (i > found && point_equals(gs->sprites[i].p, p)) {
+            found = i;
+        }
+    }
+
+    if (found == ID_NIL && gs->walls[cell] && point_equals(cell_point(cell), p)) {
+        return WALL_SLOT;
+    }
+
+    return found;
+}
+
+static Point cell_point(int cell) {
+    return (Point) { (int16_t) (cell % MAP_W * TILE_W), (int16_t) (cell / MAP_W * TILE_H) };
+}
+
+static uint64_t hash_mix(uint64_t h, uint32_t w) {
+    h = (h ^ w) * 0x9e3779b97f4a7c15u;
+    return h ^ h >> 32;
+}
@@ -1,47 +1,108 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "antimatter.h"
-#include "backend.h"
 #include "sprite.h"
 
 typedef struct GameState GameState;
-typedef bool SceneFn(GameState* gs, Backend* be);
+
+typedef enum {
+    SC_SPLASH,
+    SC_TITLE_ANIM,
+    SC_TITLE_MOVE,
+    SC_TITLE,
+    SC_FADE_OUT,
+    SC_START_LEVEL,
+    SC_PLAYING,
+    SC_PAUSED,
+    SC_WAIT,
+    SC_SWAP,
+    SC_LEVEL_CLEAR,
+    SC_CLEAR_WAIT,
+    SC_DEATH1,
+    SC_DEATH2,
+    SC_GAME_OVER,
+    SC_COUNT,
+} SceneId;
+
+typedef enum {
+    GE_MOVE,
+    GE_DESTROY,
+    GE_EXPLODE,
+    GE_EXHAUSTED,
+    GE_CLEAR,
+} GameEvent;
+
+typedef struct {
+    void (*emit)(void* ctx, GameState* gs, GameEvent ev);
+    void* ctx;
+} EventSink;
+
+typedef struct {
+    int32_t to_clear;
+    uint32_t n_sprites;
+    bool wraps;
+    uint8_t walls[MAP_W * MAP_H];
+    uint8_t grid[MAP_W * MAP_H];
+    uint8_t regions[MAP_W * MAP_H];
+    uint8_t grid_next[MAX_SPRITES];
+    Sprite sprites[MAX_SPRITES];
+} LevelState;
 
 struct GameState {
-    SceneFn* scene;
-    float phase;
-    float spd_mod;
+    uint8_t scene;
+    int32_t phase;
+    int32_t spd_mod;
+    int64_t clock;
+    int64_t acc;
     int64_t start;
     int64_t delay;
     int64_t prev;
     int64_t lag;
+    uint32_t tick;
     int32_t level;
     int32_t high;
     int32_t score;
+    int32_t gain;
     int32_t energy;
     int32_t lives;
     int32_t to_clear;
     uint32_t n_sprites;
+    uint8_t n_doomed;
+    uint8_t doomed[MAX_DOOMED];
+    uint8_t n_pending;
+    Delta pending[MAX_PENDING];
+    uint8_t walls[MAP_W * MAP_H];
+    uint8_t grid[MAP_W * MAP_H];
+    uint8_t grid_next[MAX_SPRITES];
     bool los;
+    bool swapped;
+    bool fixed;
+    bool wraps;
     Adjacent adj_a;
     Adjacent adj_m;
+    Sprite wall;
     Sprite sprites[MAX_SPRITES];
 };
 
 GameState* gs_init(double start_t);
-float gs_phase(GameState* gs);
-bool gs_update(GameState* gs, Backend* be, double timestamp);
-void gs_limit_fps(GameState* self);
-void gs_set_scene(GameState* gs, SceneFn* scene, uint32_t delay);
+int32_t gs_phase(GameState* gs);
+uint32_t gs_advance_clock(GameState* gs, double timestamp);
+void gs_tick(GameState* gs);
+void gs_set_scene(GameState* gs, uint8_t scene, uint32_t delay);
 void gs_load_level(GameState* gs);
+const LevelState* gs_level_state(int32_t level);
+void gs_decode_level(GameState* gs);
 void gs_adv_state(GameState* gs);
-void gs_move_pcs(GameState* gs, Backend* be, int8_t dx, int8_t dy);
+void gs_move_pcs(GameState* gs, EventSink* sink, int8_t dx, int8_t dy);
+bool gs_start_move(GameState* gs, EventSink* sink, int8_t dx, int8_t dy);
 void gs_swap_sprites(GameState* gs);
-void gs_post_update(GameState* gs, Backend* be);
+void gs_post_update(GameState* gs, EventSink* sink);
 void gs_score(GameState* gs, int32_t n);
-void gs_render_default(GameState* gs, Backend* be);
-void gs_render_sprites(GameState* gs, Backend* be);
-void gs_render_help(GameState* gs, Backend* be);
-void gs_decorate(Backend* be);
+void gs_reindex(GameState* gs);
+uint64_t gs_hash(GameState* gs);
+Sprite* gs_sprite(GameState* gs, uint8_t slot);
+void gs_put_sprite(GameState* gs, uint8_t slot, uint8_t id, Point p);
+void gs_insert_sprite(GameState* gs, uint8_t slot, uint8_t id, Point p);
 void gs_quit(GameState* gs);
@@ -0,0 +1,445 @@
+#pragma once
+#include "gamestate.h"
+
+static const LevelState LEVEL_STATE[MAX_LEVEL] = {
+    {
+        .to_clear = 2,
+        .n_sprites = 5,
+        .wraps = false,
+        .walls = {
+             50,  54,  54,  54,  54,  54,  54,  54,  54,  54,  51,  55,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,  55,  55,   0,   0,  50,  54,  88,  54,  51,   0,   0,
+             55,  55,   0,   0,  59,  60,  87,  60,  59,   0,   0,  55,  55,   0,   0,  53,
+             54,  89,  54,  89,  54,  54,  58,  55,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,  55,  57,  54,  54,  88,  54,  88,  54,  51,   0,   0,  55,  55,   0,   0,
+             59,  60,  87,  60,  59,   0,   0,  55,  55,   0,   0,  53,  54,  89,  54,  52,
+              0,   0,  55,  55,   0,   0,   0,   0,   0,   0,   0,   0,   0,  55,  53,  54,
+             54,  54,  54,  54,  54,  54,  54,  54,  52,
+        },
+        .grid = {
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   2,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   3,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   4,   0,   0,   0,   0,   0,   0,   0,   1,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,
+        },
+        .regions = {
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,
+              1,   1,   1,   1,   1,   0,   0,   1,   1,   0,   0,   0,   0,   0,   1,   1,
+              0,   0,   1,   1,   0,   0,   0,   0,   0,   1,   1,   0,   0,   1,   1,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,   1,   1,   1,   1,
+              1,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,   1,   0,   0,   1,   1,
+              0,   0,   0,   0,   0,   1,   1,   0,   0,   1,   1,   0,   0,   0,   0,   0,
+              1,   1,   0,   0,   1,   1,   1,   1,   1,   1,   1,   1,   1,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,
+        },
+        .grid_next = {
+              0,   0,   0,   0,   0,
+        },
+        .sprites = {
+            { { -1, -1 }, { 0, 0 }, 1, 0 },
+            { { 144, 144 }, { 0, 0 }, 42, 1 },
+            { { 16, 16 }, { 0, 0 }, 58, 9 },
+            { { 144, 48 }, { 0, 0 }, 28, 25 },
+            { { 16, 144 }, { 0, 0 }, 12, 17 },
+        },
+    },
+    {
+        .to_clear = 4,
+        .n_sprites = 7,
+        .wraps = true,
+        .walls = {
+             54,  54,  54,  54,  54,  51,   0,  59,  60,  60,  60,   0,   0,   0,   0,   0,
+             55,   0,   0,   0,   0,   0,  60,  60,  60,  59,   0,  53,  54,  54,   0,  54,
+             54,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,  54,  54,   0,  54,  54,  51,   0,  59,  60,  60,  60,   0,   0,   0,
+              0,   0,  55,   0,   0,   0,   0,   0,  60,  60,  60,  59,   0,  53,  54,  54,
+             54,  54,  54,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,
+        },
+        .grid = {
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   3,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   4,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   5,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   6,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   1,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   2,
+        },
+        .regions = {
+              0,   0,   0,   0,   0,   0,   1,   0,   0,   0,   0,   1,   1,   1,   1,   1,
+              0,   1,   1,   1,   1,   1,   0,   0,   0,   0,   1,   0,   0,   0,   1,   0,
+              0,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+              1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+              1,   1,   0,   0,   1,   0,   0,   0,   1,   0,   0,   0,   0,   1,   1,   1,
+              1,   1,   0,   1,   1,   1,   1,   1,   0,   0,   0,   0,   1,   0,   0,   0,
+              0,   0,   0,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+              1,   1,   1,   1,   1,   1,   1,   1,   1,
+        },
+        .grid_next = {
+              0,   0,   0,   0,   0,   0,   0,
+        },
+        .sprites = {
+            { { -1, -1 }, { 0, 0 }, 1, 0 },
+            { { 0, 144 }, { 0, 0 }, 42, 1 },
+            { { 160, 160 }, { 0, 0 }, 58, 9 },
+            { { 128, 16 }, { 0, 0 }, 12, 17 },
+            { { 128, 32 }, { 0, 0 }, 12, 17 },
+            { { 32, 96 }, { 0, 0 }, 28, 25 },
+            { { 32, 112 }, { 0, 0 }, 28, 25 },
+        },
+    },
+    {
+        .to_clear = 4,
+        .n_sprites = 17,
+        .wraps = true,
+        .walls = {
+              0,   0,   0,   0,  50,  88,  51,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,  53,  89,  52,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,  50,   0,  51,   0,
+              0,   0,   0,   0,  50,   0,  51,  57,   0,  58,   0,   0,   0,   0,   0,  57,
+              0,  58,  53,   0,  52,   0,   0,   0,   0,   0,  53,   0,  52,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,  50,  88,  51,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,  53,  89,  52,   0,   0,   0,   0,
+        },
+        .grid = {
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   2,   0,   0,   3,
+              4,   5,   0,   0,   6,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   7,   0,   0,
+              0,   0,   0,   0,   0,   8,   0,   0,   9,   0,   0,   0,   0,   0,   0,   0,
+             10,   0,   0,  11,   0,   0,   0,   0,   0,   0,   0,  12,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,  13,   0,   0,  14,  15,  16,   0,   0,   1,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,
+        },
+        .regions = {
+              1,   1,   1,   1,   0,   0,   0,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+              1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   0,   0,   0,   1,   1,   1,
+              1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   0,   1,   0,   1,
+              1,   1,   1,   1,   0,   1,   0,   0,   1,   0,   1,   1,   1,   1,   1,   0,
+              1,   0,   0,   1,   0,   1,   1,   1,   1,   1,   0,   1,   0,   1,   1,   1,
+              1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   0,   0,   0,   1,
+              1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+              1,   1,   0,   0,   0,   1,   1,   1,   1,
+        },
+        .grid_next = {
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,
+        },
+        .sprites = {
+            { { -1, -1 }, { 0, 0 }, 1, 0 },
+            { { 144, 144 }, { 0, 0 }, 42, 1 },
+            { { 16, 16 }, { 0, 0 }, 58, 9 },
+            { { 64, 16 }, { 0, 0 }, 60, 37 },
+            { { 80, 16 }, { 0, 0 }, 28, 25 },
+            { { 96, 16 }, { 0, 0 }, 60, 37 },
+            { { 144, 16 }, { 0, 0 }, 44, 33 },
+            { { 16, 64 }, { 0, 0 }, 44, 33 },
+            { { 144, 64 }, { 0, 0 }, 44, 33 },
+            { { 16, 80 }, { 0, 0 }, 12, 17 },
+            { { 144, 80 }, { 0, 0 }, 12, 17 },
+            { { 16, 96 }, { 0, 0 }, 44, 33 },
+            { { 144, 96 }, { 0, 0 }, 44, 33 },
+            { { 16, 144 }, { 0, 0 }, 60, 37 },
+            { { 64, 144 }, { 0, 0 }, 60, 37 },
+            { { 80, 144 }, { 0, 0 }, 28, 25 },
+            { { 96, 144 }, { 0, 0 }, 60, 37 },
+        },
+    },
+    {
+        .to_clear = 16,
+        .n_sprites = 34,
+        .wraps = true,
+        .walls = {
+             54,  88,  54,  54,  54,  54,  54,  88,  54,  54,  54,  54,  89,  54,  54,  88,
+             54,  54,  89,  54,  54,  88,  54,  88,  54,  54,  89,  54,  54,  88,  54,  54,
+             89,  54,  89,  54,  54,  54,  54,  54,  89,  54,  54,  54,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,  54,  54,  54,
+             54,  88,  54,  54,  54,  54,  54,  88,  54,  88,  54,  54,  89,  54,  54,  88,
+             54,  54,  89,  54,  89,  54,  54,  88,  54,  54,  89,  54,  54,  88,  54,  54,
+             54,  54,  89,  54,  54,  54,  54,  54,  89,
+        },
+        .grid = {
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   2,   3,   4,   5,
+              6,   7,   8,   9,  10,  11,  12,  13,  14,  15,  16,  17,  18,  19,  20,  21,
+             22,  23,  24,  25,  26,  27,  28,  29,  30,  31,  32,  33,   1,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,
+        },
+        .regions = {
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,
+              1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+              1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,
+        },
+        .grid_next = {
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,
+        },
+        .sprites = {
+            { { -1, -1 }, { 0, 0 }, 1, 0 },
+            { { 160, 96 }, { 0, 0 }, 42, 1 },
+            { { 0, 64 }, { 0, 0 }, 58, 9 },
+            { { 16, 64 }, { 0, 0 }, 44, 33 },
+            { { 32, 64 }, { 0, 0 }, 60, 37 },
+            { { 48, 64 }, { 0, 0 }, 28, 25 },
+            { { 64, 64 }, { 0, 0 }, 60, 37 },
+            { { 80, 64 }, { 0, 0 }, 60, 37 },
+            { { 96, 64 }, { 0, 0 }, 28, 25 },
+            { { 112, 64 }, { 0, 0 }, 12, 17 },
+            { { 128, 64 }, { 0, 0 }, 60, 37 },
+            { { 144, 64 }, { 0, 0 }, 12, 17 },
+            { { 160, 64 }, { 0, 0 }, 28, 25 },
+            { { 0, 80 }, { 0, 0 }, 44, 33 },
+            { { 16, 80 }, { 0, 0 }, 28, 25 },
+            { { 32, 80 }, { 0, 0 }, 12, 17 },
+            { { 48, 80 }, { 0, 0 }, 60, 37 },
+            { { 64, 80 }, { 0, 0 }, 12, 17 },
+            { { 80, 80 }, { 0, 0 }, 60, 37 },
+            { { 96, 80 }, { 0, 0 }, 12, 17 },
+            { { 112, 80 }, { 0, 0 }, 44, 33 },
+            { { 128, 80 }, { 0, 0 }, 12, 17 },
+            { { 144, 80 }, { 0, 0 }, 28, 25 },
+            { { 160, 80 }, { 0, 0 }, 44, 33 },
+            { { 0, 96 }, { 0, 0 }, 28, 25 },
+            { { 16, 96 }, { 0, 0 }, 12, 17 },
+            { { 32, 96 }, { 0, 0 }, 44, 33 },
+            { { 48, 96 }, { 0, 0 }, 12, 17 },
+            { { 64, 96 }, { 0, 0 }, 28, 25 },
+            { { 80, 96 }, { 0, 0 }, 44, 33 },
+            { { 96, 96 }, { 0, 0 }, 60, 37 },
+            { { 112, 96 }, { 0, 0 }, 28, 25 },
+            { { 128, 96 }, { 0, 0 }, 44, 33 },
+            { { 144, 96 }, { 0, 0 }, 60, 37 },
+        },
+    },
+    {
+        .to_clear = 8,
+        .n_sprites = 11,
+        .wraps = true,
+        .walls = {
+              0,   0,   0,  55,   0,   0,   0,  55,   0,   0,   0,   0,  59,   0,   0,   0,
+              0,   0,  55,   0,   0,   0,   0,   0,   0,  55,   0,   0,   0,  55,   0,   0,
+              0,  54,   0,  54,  56,  54,   0,  54,  56,  54,   0,  54,   0,   0,   0,  55,
+              0,   0,   0,  55,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,  55,   0,   0,   0,  55,   0,   0,   0,  54,  54,  54,
+             56,  54,   0,  54,  56,  54,   0,  54,   0,   0,   0,  55,   0,   0,   0,  55,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,  55,   0,   0,   0,  55,   0,   0,   0,
+        },
+        .grid = {
+              2,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              3,   0,   0,   0,   4,   0,   0,   0,   1,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   5,   0,   0,   0,   6,   0,   0,   0,
+              7,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   8,   0,   0,   0,   9,   0,   0,   0,  10,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,
+        },
+        .regions = {
+              1,   1,   1,   0,   1,   1,   1,   0,   1,   1,   1,   1,   0,   1,   1,   1,
+              1,   1,   0,   1,   1,   1,   1,   1,   1,   0,   1,   1,   1,   0,   1,   1,
+              1,   0,   1,   0,   0,   0,   1,   0,   0,   0,   1,   0,   1,   1,   1,   0,
+              1,   1,   1,   0,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+              1,   1,   1,   1,   1,   0,   1,   1,   1,   0,   1,   1,   1,   0,   0,   0,
+              0,   0,   1,   0,   0,   0,   1,   0,   1,   1,   1,   0,   1,   1,   1,   0,
+              1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+              1,   0,   1,   1,   1,   0,   1,   1,   1,
+        },
+        .grid_next = {
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+        },
+        .sprites = {
+            { { -1, -1 }, { 0, 0 }, 1, 0 },
+            { { 32, 32 }, { 0, 0 }, 42, 1 },
+            { { 0, 0 }, { 0, 0 }, 58, 9 },
+            { { 80, 16 }, { 0, 0 }, 28, 25 },
+            { { 144, 16 }, { 0, 0 }, 12, 17 },
+            { { 16, 80 }, { 0, 0 }, 28, 25 },
+            { { 80, 80 }, { 0, 0 }, 12, 17 },
+            { { 144, 80 }, { 0, 0 }, 28, 25 },
+            { { 16, 144 }, { 0, 0 }, 12, 17 },
+            { { 80, 144 }, { 0, 0 }, 28, 25 },
+            { { 144, 144 }, { 0, 0 }, 12, 17 },
+        },
+    },
+    {
+        .to_clear = 8,
+        .n_sprites = 28,
+        .wraps = true,
+        .walls = {
+              0,  55,  55,   0,   0,   0,   0,   0,  55,  55,   0,  54,  56,  52,   0,   0,
+              0,   0,   0,  53,  56,  54,  54,  52,   0,   0,   0,   0,   0,   0,   0,  53,
+             54,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,  54,  51,   0,   0,   0,   0,   0,   0,
+              0,  50,  54,  54,  56,  51,   0,   0,   0,   0,   0,  50,  56,  54,   0,  55,
+             55,   0,   0,   0,   0,   0,  55,  55,   0,
+        },
+        .grid = {
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   3,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   4,   5,   6,   0,   0,   0,   0,   0,   0,   0,   7,
+              8,   9,  10,  11,   0,   0,   0,   0,   1,  12,  13,  14,  15,  16,  17,  18,
+              2,   0,   0,   0,   0,  19,  20,  21,  22,  23,   0,   0,   0,   0,   0,   0,
+              0,  24,  25,  26,   0,   0,   0,   0,   0,   0,   0,   0,   0,  27,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,
+        },
+        .regions = {
+              1,   0,   0,   2,   2,   2,   2,   2,   0,   0,   3,   0,   0,   0,   2,   2,
+              2,   2,   2,   0,   0,   0,   0,   0,   2,   2,   2,   2,   2,   2,   2,   0,
+              0,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,
+              2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,
+              2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,   2,
+              2,   2,   2,   2,   2,   2,   2,   2,   0,   0,   2,   2,   2,   2,   2,   2,
+              2,   0,   0,   0,   0,   0,   2,   2,   2,   2,   2,   0,   0,   0,   4,   0,
+              0,   2,   2,   2,   2,   2,   0,   0,   5,
+        },
+        .grid_next = {
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+        },
+        .sprites = {
+            { { -1, -1 }, { 0, 0 }, 1, 0 },
+            { { 16, 80 }, { 0, 0 }, 42, 1 },
+            { { 144, 80 }, { 0, 0 }, 58, 9 },
+            { { 80, 32 }, { 0, 0 }, 28, 25 },
+            { { 64, 48 }, { 0, 0 }, 60, 37 },
+            { { 80, 48 }, { 0, 0 }, 44, 33 },
+            { { 96, 48 }, { 0, 0 }, 60, 37 },
+            { { 48, 64 }, { 0, 0 }, 60, 37 },
+            { { 64, 64 }, { 0, 0 }, 44, 33 },
+            { { 80, 64 }, { 0, 0 }, 12, 17 },
+            { { 96, 64 }, { 0, 0 }, 44, 33 },
+            { { 112, 64 }, { 0, 0 }, 60, 37 },
+            { { 32, 80 }, { 0, 0 }, 28, 25 },
+            { { 48, 80 }, { 0, 0 }, 44, 33 },
+            { { 64, 80 }, { 0, 0 }, 12, 17 },
+            { { 80, 80 }, { 0, 0 }, 60, 37 },
+            { { 96, 80 }, { 0, 0 }, 12, 17 },
+            { { 112, 80 }, { 0, 0 }, 44, 33 },
+            { { 128, 80 }, { 0, 0 }, 28, 25 },
+            { { 48, 96 }, { 0, 0 }, 60, 37 },
+            { { 64, 96 }, { 0, 0 }, 44, 33 },
+            { { 80, 96 }, { 0, 0 }, 12, 17 },
+            { { 96, 96 }, { 0, 0 }, 44, 33 },
+            { { 112, 96 }, { 0, 0 }, 60, 37 },
+            { { 64, 112 }, { 0, 0 }, 60, 37 },
+            { { 80, 112 }, { 0, 0 }, 44, 33 },
+            { { 96, 112 }, { 0, 0 }, 60, 37 },
+            { { 80, 128 }, { 0, 0 }, 28, 25 },
+        },
+    },
+    {
+        .to_clear = 12,
+        .n_sprites = 51,
+        .wraps = true,
+        .walls = {
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+             59,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,  61,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,  61,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,  61,   0,   0,   0,   0,   0,   0,  59,  60,  60,  60,  87,  60,  60,  60,
+             59,   0,   0,   0,   0,   0,   0,  61,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,  61,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,  61,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,  59,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,
+        },
+        .grid = {
+              3,   4,   5,   6,   7,   0,   8,   9,  10,  11,  12,  13,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,  14,  15,   0,   2,   0,   0,   0,   0,   0,   0,   0,
+             16,  17,   0,   0,   0,  18,   0,  19,   0,   0,   0,  20,  21,   0,   0,  22,
+             23,   0,  24,  25,   0,   0,  26,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,  27,   0,   0,  28,  29,   0,  30,  31,   0,   0,  32,  33,   0,   0,
+              0,  34,   0,  35,   0,   0,   0,  36,  37,   0,   0,   0,   0,   0,   0,   0,
+              1,   0,  38,  39,   0,   0,   0,   0,   0,   0,   0,   0,   0,  40,  41,  42,
+             43,  44,  45,   0,  46,  47,  48,  49,  50,
+        },
+        .regions = {
+              1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+              0,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   0,   1,   1,   1,   1,
+              1,   1,   1,   1,   1,   1,   0,   1,   1,   1,   1,   1,   1,   1,   1,   1,
+              1,   0,   1,   1,   1,   1,   1,   1,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   1,   1,   1,   1,   1,   1,   0,   1,   1,   1,   1,   1,   1,   1,   1,
+              1,   1,   0,   1,   1,   1,   1,   1,   1,   1,   1,   1,   1,   0,   1,   1,
+              1,   1,   1,   1,   1,   1,   1,   1,   0,   1,   1,   1,   1,   1,   1,   1,
+              1,   1,   1,   1,   1,   1,   1,   1,   1,
+        },
+        .grid_next = {
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+              0,   0,   0,
+        },
+        .sprites = {
+            { { -1, -1 }, { 0, 0 }, 1, 0 },
+            { { 128, 128 }, { 0, 0 }, 42, 1 },
+            { { 32, 32 }, { 0, 0 }, 58, 9 },
+            { { 0, 0 }, { 0, 0 }, 60, 37 },
+            { { 16, 0 }, { 0, 0 }, 60, 37 },
+            { { 32, 0 }, { 0, 0 }, 60, 37 },
+            { { 48, 0 }, { 0, 0 }, 60, 37 },
+            { { 64, 0 }, { 0, 0 }, 60, 37 },
+            { { 96, 0 }, { 0, 0 }, 44, 33 },
+            { { 112, 0 }, { 0, 0 }, 44, 33 },
+            { { 128, 0 }, { 0, 0 }, 44, 33 },
+            { { 144, 0 }, { 0, 0 }, 44, 33 },
+            { { 160, 0 }, { 0, 0 }, 44, 33 },
+            { { 0, 16 }, { 0, 0 }, 60, 37 },
+            { { 160, 16 }, { 0, 0 }, 44, 33 },
+            { { 0, 32 }, { 0, 0 }, 60, 37 },
+            { { 160, 32 }, { 0, 0 }, 44, 33 },
+            { { 0, 48 }, { 0, 0 }, 60, 37 },
+            { { 64, 48 }, { 0, 0 }, 12, 17 },
+            { { 96, 48 }, { 0, 0 }, 28, 25 },
+            { { 160, 48 }, { 0, 0 }, 44, 33 },
+            { { 0, 64 }, { 0, 0 }, 60, 37 },
+            { { 48, 64 }, { 0, 0 }, 12, 17 },
+            { { 64, 64 }, { 0, 0 }, 12, 17 },
+            { { 96, 64 }, { 0, 0 }, 28, 25 },
+            { { 112, 64 }, { 0, 0 }, 28, 25 },
+            { { 160, 64 }, { 0, 0 }, 44, 33 },
+            { { 0, 96 }, { 0, 0 }, 44, 33 },
+            { { 48, 96 }, { 0, 0 }, 28, 25 },
+            { { 64, 96 }, { 0, 0 }, 28, 25 },
+            { { 96, 96 }, { 0, 0 }, 12, 17 },
+            { { 112, 96 }, { 0, 0 }, 12, 17 },
+            { { 160, 96 }, { 0, 0 }, 60, 37 },
+            { { 0, 112 }, { 0, 0 }, 44, 33 },
+            { { 64, 112 }, { 0, 0 }, 28, 25 },
+            { { 96, 112 }, { 0, 0 }, 12, 17 },
+            { { 160, 112 }, { 0, 0 }, 60, 37 },
+            { { 0, 128 }, { 0, 0 }, 44, 33 },
+            { { 160, 128 }, { 0, 0 }, 60, 37 },
+            { { 0, 144 }, { 0, 0 }, 44, 33 },
+            { { 160, 144 }, { 0, 0 }, 60, 37 },
+            { { 0, 160 }, { 0, 0 }, 44, 33 },
+            { { 16, 160 }, { 0, 0 }, 44, 33 },
+            { { 32, 160 }, { 0, 0 }, 44, 33 },
+            { { 48, 160 }, { 0, 0 }, 44, 33 },
+            { { 64, 160 }, { 0, 0 }, 44, 33 },
+            { { 96, 160 }, { 0, 0 }, 60, 37 },
+            { { 112, 160 }, { 0, 0 }, 60, 37 },
+            { { 128, 160 }, { 0, 0 }, 60, 37 },
+            { { 144, 160 }, { 0, 0 }, 60, 37 },
+            { { 160, 160 }, { 0, 0 }, 60, 37 },
+        },
+    },
+};
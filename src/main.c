@@ -1,35 +1,29 @@
-#include "gamestate.h"
+#include "render.h"
+#include "scene.h"
+
+static void am_setup(Backend* be, GameState* gs);
+
+#ifdef WASM_BACKEND
 
 static Backend* be = NULL;
 static GameState* gs = NULL;
 
-#ifdef WASM_BACKEND
 __attribute__((export_name("am_init")))
-#endif
 int am_init(double start_t);
 
-#ifdef WASM_BACKEND
 __attribute__((export_name("am_update")))
-#endif
 int am_update(double timestamp);
 
-void am_quit(void);
-
 int am_init(double start_t) {
     if (be == NULL && gs == NULL) {
         be = be_init();
         gs = gs_init(start_t);
 
-        if (be == NULL || gs == NULL) { 
-            return -1; 
+        if (be == NULL || gs == NULL) {
+            return -1;
         }
 
-        be_send_audiomsg(be, MSG_PLAY);
-        be_set_render_target(be, 1);
-        gs_decorate(be);
-        be_set_render_target(be, 0);
-        be_set_color(be, 4);
-
+        am_setup(be, gs);
         return 0;
     }
 
@@ -37,37 +31,119 @@ int am_init(double start_t) {
 }
 
 int am_update(double timestamp) {
-    if (be == NULL || gs == NULL) { 
+    if (be == NULL || gs == NULL) {
         return 0;
     }
 
     return gs_update(gs, be, timestamp);
 }
 
-void am_quit(void) {
-    if (gs != NULL) {
-        gs_quit(gs);
-        gs = NULL;
+int main(void) {
+    return 0;
+}
+
+#elif defined(REPLAY_BACKEND)
+
+#include <time.h>
+
+static double am_run(Backend* be, GameState* gs, double time, uint32_t tick);
+static double am_seek(Backend* be, GameState* gs, double time, uint32_t tick);
+
+int main(void) {
+    Backend* be = be_init();
+    GameState* gs = gs_init(0.0);
+
+    if (be == NULL || gs == NULL) {
+        return EXIT_FAILURE;
     }
 
-    if (be != NULL) {
-        be_quit(be);
-        be = NULL;
+    gs->fixed = true;
+    am_setup(be, gs);
+    double time = 0.0;
+    char* seek = getenv("AM_SEEK");
+
+    if (seek != NULL) {
+        uint32_t tick = (uint32_t) strtoul(seek, NULL, 10);
+        clock_t t0 = clock();
+        time = am_seek(be, gs, time, tick);
+        double ms = (double) (clock() - t0) * 1000.0 / CLOCKS_PER_SEC;
+        printf("seek: tick %u hash %016llx in %.3f ms\n", gs->tick,
+               (unsigned long long) gs_hash(gs), ms);
     }
+
+    am_run(be, gs, time, be->hdr.end_tick);
+    uint64_t hash = gs_hash(gs);
+    bool ok = gs->tick == be->hdr.end_tick && hash == be->hdr.end_hash;
+    printf("%s: tick %u hash %016llx, expected tick %u hash %016llx\n", ok ? "ok" : "MISMATCH",
+           gs->tick, (unsigned long long) hash,
+           be->hdr.end_tick, (unsigned long long) be->hdr.end_hash);
+
+    sc_quit(be);
+    gs_quit(gs);
+    be_quit(be);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
+static double am_run(Backend* be, GameState* gs, double time, uint32_t tick) {
+    while (gs->tick < tick && gs_update(gs, be, time)) {
+        time += TICK_MS;
+    }
+
+    return time;
+}
+
+static double am_seek(Backend* be, GameState* gs, double time, uint32_t tick) {
+    const Keyframe* kf = be_find_keyframe(be, tick);
+
+    if (kf != NULL && (kf->state.tick > gs->tick || tick < gs->tick) && sc_restore(gs, be, kf)) {
+        be_seek_input(be, gs->tick);
+    }
+
+    return am_run(be, gs, time, tick);
+}
+
+#else
+
 int main(void) {
     double time = be_get_millis();
+    Backend* be = be_init();
+    GameState* gs = gs_init(time);
 
-    if (am_init(time)) {
+    if (be == NULL || gs == NULL) {
         return EXIT_FAILURE;
     }
 
-    while (am_update(time)) {
-        gs_limit_fps(gs);    
+    am_setup(be, gs);
+
+    while (gs_update(gs, be, time)) {
+        gs_limit_fps(gs);
         time = be_get_millis();
     }
 
-    am_quit();
+    sc_keyframe(gs, be);
+    sc_quit(be);
+    gs_quit(gs);
+    be_quit(be);
     return EXIT_SUCCESS;
 }
+
+#endif
+
+static void am_setup(Backend* be, GameState* gs) {
+    sc_init(be);
+#ifdef FIXED_STEP
+    gs->fixed = true;
+#endif
+    be_send_audiomsg(be, MSG_PLAY);
+
+    if (!sc_resume(gs, be)) {
+        gs_set_scene(gs, SC_SPLASH, 5);
+    }
+
+    sc_keyframe(gs, be);
+
+    be_set_render_target(be, 1);
+    gs_decorate(be);
+    be_set_render_target(be, 0);
+    be_set_color(be, 4);
+}
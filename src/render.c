@@ -0,0 +1,131 @@
+#include <stdio.h>
+#include "render.h"
+
+static void render_stats(GameState* gs, Backend* be);
+
+void gs_render_default(GameState* gs, Backend* be) {
+    be_fill_rect(be, 184, 0, 72, 192); 
+    be_blit_static(be);
+    render_stats(gs, be);
+}
+
+void gs_render_help(GameState* gs, Backend* be) {
+    int x = 42;
+    int y = 28;
+    int m = 14;
+
+    if (gs->phase > PHASE_ONE / 4) {
+        be_blit_text(be, x + 31, y, "PAUSED");
+    }
+
+    be_blit_text(be, x, y + m * 1, "ESC     RESUME"); 
+    be_blit_text(be, x, y + m * 2, "F1     RESTART");
+    be_blit_text(be, x, y + m * 3, "F2        MUTE"); 
+    be_blit_text(be, x, y + m * 4, "F3       SCALE"); 
+    be_blit_text(be, x, y + m * 5, "F4     FULLSCR"); 
+    be_blit_text(be, x, y + m * 6, "F5       VOL -"); 
+    be_blit_text(be, x, y + m * 7, "F6       VOL +"); 
+    be_blit_text(be, x, y + m * 8, "F7        UNDO"); 
+    be_blit_text(be, x, y + m * 9, "F8        REDO"); 
+    be_blit_text(be, x, y + m * 10, "F10       QUIT"); 
+}
+
+void gs_render_sprites(GameState* gs, Backend* be) {
+    int16_t bound_x = MAX_X - TILE_W;
+    int16_t bound_y = MAX_Y - TILE_H;
+    int16_t fw = FRAME_W;
+
+    for (int i = 0; i < MAP_W * MAP_H; i++) {
+        if (gs->walls[i]) {
+            be_blit_tile(be, i % MAP_W * TILE_W + fw, i / MAP_W * TILE_H + fw, gs->walls[i]);
+        }
+    }
+
+    for (size_t i = 1; i < gs->n_sprites; i++) {
+        Sprite* s = &gs->sprites[i];
+
+        if (!has_flag(s, F_NIL)) {
+            int16_t x = s->p.x;
+            int16_t y = s->p.y;
+            int tile = s->tile;
+            int offset = gs->phase * gs->spd_mod / PHASE_ONE;
+
+            if (has_flag(s, F_ANIMATED)) {
+                tile += (4 - offset % 4) % 4;
+            } 
+
+            if (x > bound_x) {
+                int16_t x2 = x - MAX_X; 
+                be_blit_tile(be, x2 + fw, y + fw, tile);
+            } else if (y > bound_y) {
+                int16_t y2 = y - MAX_Y; 
+                be_blit_tile(be, x + fw, y2 + fw, tile);
+            }
+
+            be_blit_tile(be, x + fw, y + fw, tile);
+        }
+    }
+}
+
+void gs_decorate(Backend* be) {
+    uint8_t t = DECOR_TILE_BASE;
+
+    be_blit_tile(be, 0, 0, t);
+    for (int n = 16; n < 176; n += 16) {
+        be_blit_tile(be, n, 0, t + 4);
+    }
+    be_blit_tile(be, 176, 0, t + 1);
+
+    for (int n = 16; n < 176; n += 16) {
+        be_blit_tile(be, 0, n, t + 7);
+    }     
+    be_blit_tile(be, 0, 176, t + 3);
+
+    for (int n = 16; n < 176; n += 16) {
+        be_blit_tile(be, n, 176, t + 6);
+    }
+    be_blit_tile(be, 176, 176, t + 2);
+
+    for (int n = 16; n < 176; n += 16) {
+        be_blit_tile(be, 176, n, t + 5);
+    }
+    for (int y = 27; y < 183; y += 26) {
+        be_blit_tile(be, 176, y, t + 8);
+
+        for (int x = 192; x < 240; x += 16) {
+            be_blit_tile(be, x, y, t + 4);
+        }
+
+        be_blit_tile(be, 240, y, t + 9);
+    }
+
+    be_blit_tile(be, 204, 5, 80);
+    be_blit_tile(be, 220, 5, 81);
+    be_blit_tile(be, 236, 5, 82);
+
+    be_blit_tile(be, 197, 170, 83);
+    be_blit_tile(be, 197 + 16, 170, 84);
+    be_blit_tile(be, 197 + 32, 170, 85);
+    be_blit_tile(be, 197 + 48, 170, 86);
+
+    be_blit_text(be, 196, 36, "LEVEL");
+    be_blit_text(be, 196, 62, "HIGH");
+    be_blit_text(be, 196, 88, "SCORE"); 
+    be_blit_text(be, 196, 114, "ENERGY"); 
+    be_blit_text(be, 196, 140, "LIVES"); 
+}
+
+static void render_stats(GameState* gs, Backend* be) {
+    char level[8], high[8], score[8], energy[8], lives[8];
+    snprintf(level, 8, "%7d", gs->level);
+    snprintf(high, 8, "%7d", gs->high);
+    snprintf(score, 8, "%7d", gs->score);
+    snprintf(energy, 8, "%7d", gs->energy);
+    snprintf(lives, 8, "%7d", gs->lives);
+    be_blit_text(be, 196, 45, level); 
+    be_blit_text(be, 196, 71, high); 
+    be_blit_text(be, 196, 97, score); 
+    be_blit_text(be, 196, 123, energy); 
+    be_blit_text(be, 196, 149, lives); 
+}
+
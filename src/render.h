@@ -0,0 +1,9 @@
+#pragma once
+
+#include "backend.h"
+#include "gamestate.h"
+
+void gs_render_default(GameState* gs, Backend* be);
+void gs_render_sprites(GameState* gs, Backend* be);
+void gs_render_help(GameState* gs, Backend* be);
+void gs_decorate(Backend* be);
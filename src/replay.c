@@ -0,0 +1,111 @@
+#include <stdlib.h>
+#include "replay.h"
+
+_Static_assert(sizeof(Keyframe) % _Alignof(UndoEntry) == 0, "Keyframe layout");
+_Static_assert(sizeof(UndoEntry) % _Alignof(Keyframe) == 0, "UndoEntry layout");
+
+static bool reserve(KeyframeLog* kl, uint32_t size);
+
+KeyframeLog* rp_init(void) {
+    KeyframeLog* kl = calloc(1, sizeof(KeyframeLog));
+    LOG_ERR(kl == NULL, "alloc failure")
+    return kl;
+}
+
+void rp_add_keyframe(KeyframeLog* kl, const SaveState* ss, UndoLog* ud) {
+    uint32_t n_undo = ud != NULL ? ud->len + ud->redo : 0;
+    uint32_t size = (uint32_t) (sizeof(Keyframe) + n_undo * sizeof(UndoEntry));
+
+    if (!reserve(kl, size)) {
+        return;
+    }
+
+    Keyframe* kf = (Keyframe*) &kl->data[kl->size];
+    kf->state = *ss;
+    kf->undo_len = ud != NULL ? ud->len : 0;
+    kf->undo_redo = ud != NULL ? ud->redo : 0;
+
+    if (ud != NULL) {
+        ud_export(ud, (UndoEntry*) (kf + 1));
+    }
+
+    kl->index[kl->len++] = (KeyframeRef) { ss->tick, kl->size };
+    kl->size += size;
+}
+
+bool rp_check_keyframes(const KeyframeRef* index, uint32_t len, const uint8_t* data, uint32_t size) {
+    for (uint32_t i = 0; i < len; i++) {
+        uint32_t offset = index[i].offset;
+
+        if (offset % _Alignof(Keyframe) != 0 || offset > size || size - offset < sizeof(Keyframe) ||
+                (i > 0 && index[i].tick < index[i - 1].tick)) {
+            return false;
+        }
+
+        const Keyframe* kf = (const Keyframe*) &data[offset];
+        uint64_t n_undo = (uint64_t) kf->undo_len + kf->undo_redo;
+
+        if (kf->state.tick != index[i].tick || n_undo > UNDO_DEPTH ||
+                size - offset - sizeof(Keyframe) < n_undo * sizeof(UndoEntry)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+const KeyframeRef* rp_find_keyframe(const KeyframeRef* index, uint32_t len, uint32_t tick) {
+    uint32_t lo = 0;
+    uint32_t hi = len;
+
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+
+        if (index[mid].tick <= tick) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return lo > 0 ? &index[lo - 1] : NULL;
+}
+
+void rp_quit(KeyframeLog* kl) {
+    free(kl->index);
+    free(kl->data);
+    free(kl);
+}
+
+static bool reserve(KeyframeLog* kl, uint32_t size) {
+    if (kl->len == kl->cap) {
+        uint32_t cap = kl->cap ? kl->cap * 2 : 64;
+        KeyframeRef* index = realloc(kl->index, cap * sizeof(KeyframeRef));
+
+        if (index == NULL) {
+            return false;
+        }
+
+        kl->index = index;
+        kl->cap = cap;
+    }
+
+    if (kl->data_cap - kl->size < size) {
+        uint32_t cap = kl->data_cap ? kl->data_cap : 1 << 16;
+
+        while (cap - kl->size < size) {
+            cap *= 2;
+        }
+
+        uint8_t* data = realloc(kl->data, cap);
+
+        if (data == NULL) {
+            return false;
+        }
+
+        kl->data = data;
+        kl->data_cap = cap;
+    }
+
+    return true;
+}
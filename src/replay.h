@@ -0,0 +1,53 @@
+#pragma once
+
+#include "savestate.h"
+#include "undo.h"
+
+#define RP_MAGIC 0x50524d41u
+#define RP_VERSION 2
+#define RP_MAX_TICKS (24u * 60 * 60 * 1000 / TICK_MS)
+
+typedef struct {
+    uint32_t tick;
+    uint32_t event;
+} ReplayInput;
+
+typedef struct {
+    uint32_t tick;
+    uint32_t offset;
+} KeyframeRef;
+
+typedef struct {
+    SaveState state;
+    uint32_t undo_len;
+    uint32_t undo_redo;
+} Keyframe;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t fixed;
+    uint32_t n_inputs;
+    uint32_t n_keyframes;
+    uint32_t kf_size;
+    uint32_t start_len;
+    uint32_t end_tick;
+    uint32_t build;
+    uint64_t end_hash;
+    SaveState start;
+} ReplayHeader;
+
+typedef struct {
+    KeyframeRef* index;
+    uint8_t* data;
+    uint32_t len;
+    uint32_t cap;
+    uint32_t size;
+    uint32_t data_cap;
+} KeyframeLog;
+
+KeyframeLog* rp_init(void);
+void rp_add_keyframe(KeyframeLog* kl, const SaveState* ss, UndoLog* ud);
+bool rp_check_keyframes(const KeyframeRef* index, uint32_t len, const uint8_t* data, uint32_t size);
+const KeyframeRef* rp_find_keyframe(const KeyframeRef* index, uint32_t len, uint32_t tick);
+void rp_quit(KeyframeLog* kl);
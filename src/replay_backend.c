@@ -0,0 +1,203 @@
+#include <stdlib.h>
+#include <string.h>
+#include "backend.h"
+
+static bool read_replay(Backend* be, FILE* file);
+
+Backend* be_init(void) {
+    char* path = getenv("AM_REPLAY");
+    LOG_ERR(path == NULL, "AM_REPLAY not set")
+    return be_open_replay(path);
+}
+
+Backend* be_open_replay(const char* path) {
+    FILE* file = fopen(path, "rb");
+    LOG_ERR(file == NULL, "cannot open replay file")
+
+    Backend* be = calloc(1, sizeof(Backend));
+    bool valid = be != NULL && read_replay(be, file);
+    fclose(file);
+
+    if (!valid && be != NULL) {
+        be_quit(be);
+    }
+
+    LOG_ERR(!valid, "invalid replay file")
+    return be;
+}
+
+Event be_get_event(Backend* be, uint32_t tick) {
+    while (be->pos < be->hdr.n_inputs && be->inputs[be->pos].tick < tick) {
+        be->pos++;
+    }
+
+    if (be->pos < be->hdr.n_inputs && be->inputs[be->pos].tick == tick) {
+        return (Event) be->inputs[be->pos++].event;
+    }
+
+    return IDLE;
+}
+
+const Keyframe* be_find_keyframe(Backend* be, uint32_t tick) {
+    const KeyframeRef* ref = rp_find_keyframe(be->kf_index, be->hdr.n_keyframes, tick);
+    return ref != NULL ? (const Keyframe*) &be->kf_data[ref->offset] : NULL;
+}
+
+void be_seek_input(Backend* be, uint32_t tick) {
+    uint32_t lo = 0;
+    uint32_t hi = be->hdr.n_inputs;
+
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+
+        if (be->inputs[mid].tick <= tick) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    be->pos = lo;
+}
+
+void be_set_color(Backend* be, int color) {
+    (void) be;
+    (void) color;
+}
+
+void be_set_render_target(Backend* be, int tgt) {
+    (void) be;
+    (void) tgt;
+}
+
+void be_clear(Backend* be) {
+    (void) be;
+}
+
+void be_present(Backend* be) {
+    (void) be;
+}
+
+void be_blit_tile(Backend* be, int x, int y, int n) {
+    (void) be;
+    (void) x;
+    (void) y;
+    (void) n;
+}
+
+void be_blit_text(Backend* be, int x, int y, char* str) {
+    (void) be;
+    (void) x;
+    (void) y;
+    (void) str;
+}
+
+void be_blit_static(Backend* be) {
+    (void) be;
+}
+
+void be_draw_line(Backend* be, int x1, int y1, int x2, int y2) {
+    (void) be;
+    (void) x1;
+    (void) y1;
+    (void) x2;
+    (void) y2;
+}
+
+void be_fill_rect(Backend* be, int x, int y, int w, int h) {
+    (void) be;
+    (void) x;
+    (void) y;
+    (void) w;
+    (void) h;
+}
+
+void be_send_audiomsg(Backend* be, int msg) {
+    (void) be;
+    (void) msg;
+}
+
+void be_record_hash(Backend* be, uint32_t tick, uint64_t hash) {
+    (void) be;
+    (void) tick;
+    (void) hash;
+}
+
+void be_save_state(Backend* be, const void* buf, size_t len) {
+    (void) be;
+    (void) buf;
+    (void) len;
+}
+
+size_t be_load_state(Backend* be, void* buf, size_t cap) {
+    size_t len = be->hdr.start_len < cap ? be->hdr.start_len : cap;
+    memcpy(buf, &be->hdr.start, len);
+    return len;
+}
+
+void be_save_keyframe(Backend* be, const SaveState* ss) {
+    (void) be;
+    (void) ss;
+}
+
+double be_get_millis(void) {
+    return 0.0;
+}
+
+void be_delay(int64_t dur) {
+    (void) dur;
+}
+
+void be_quit(Backend* be) {
+    free(be->inputs);
+    free(be->kf_index);
+    free(be->kf_data);
+    free(be);
+}
+
+static bool read_replay(Backend* be, FILE* file) {
+    ReplayHeader* hdr = &be->hdr;
+
+    if (fseek(file, 0, SEEK_END) != 0) {
+        return false;
+    }
+
+    long len = ftell(file);
+
+    if (len < (long) sizeof(ReplayHeader) || fseek(file, 0, SEEK_SET) != 0 ||
+            fread(hdr, sizeof(ReplayHeader), 1, file) != 1) {
+        return false;
+    }
+
+    uint64_t body = (uint64_t) hdr->n_inputs * sizeof(ReplayInput) +
+        (uint64_t) hdr->n_keyframes * sizeof(KeyframeRef) + hdr->kf_size;
+
+    if (hdr->magic != RP_MAGIC || hdr->version != RP_VERSION || !hdr->fixed ||
+            body > (uint64_t) len - sizeof(ReplayHeader) || hdr->start_len > sizeof(SaveState) ||
+            hdr->end_tick > RP_MAX_TICKS) {
+        return false;
+    }
+
+    if (hdr->n_inputs > 0) {
+        be->inputs = calloc(hdr->n_inputs, sizeof(ReplayInput));
+
+        if (be->inputs == NULL || fread(be->inputs, sizeof(ReplayInput), hdr->n_inputs, file) != hdr->n_inputs) {
+            return false;
+        }
+    }
+
+    if (hdr->n_keyframes > 0) {
+        be->kf_index = calloc(hdr->n_keyframes, sizeof(KeyframeRef));
+        be->kf_data = malloc(hdr->kf_size);
+
+        if (be->kf_index == NULL || be->kf_data == NULL ||
+                fread(be->kf_index, sizeof(KeyframeRef), hdr->n_keyframes, file) != hdr->n_keyframes ||
+                fread(be->kf_data, 1, hdr->kf_size, file) != hdr->kf_size) {
+            return false;
+        }
+
+        return rp_check_keyframes(be->kf_index, hdr->n_keyframes, be->kf_data, hdr->kf_size);
+    }
+
+    return true;
+}
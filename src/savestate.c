@@ -0,0 +1,175 @@
+#include <stdint.h>
+#include <string.h>
+#include "savestate.h"
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "save states are read in place and require a little-endian target"
+#endif
+
+_Static_assert(sizeof(SavedSprite) == 8, "SavedSprite layout");
+_Static_assert(sizeof(SaveState) == 736, "SaveState layout");
+_Static_assert(offsetof(SaveState, sprites) == 224, "SaveState layout");
+
+#define SS_FLAGS (F_NIL | F_PLAYER_CHAR | F_MOVABLE | F_ANIMATED | F_POLARITY | F_UNSTABLE | F_DESTROY)
+#define SS_TILES (TEXTURE_W / TILE_W * (TEXTURE_H / TILE_H))
+
+static bool valid_slot(const SaveState* ss, uint8_t slot);
+static bool valid_point(int16_t x, int16_t y);
+static bool valid_delta(int8_t dx, int8_t dy);
+static bool valid_sprite(const SavedSprite* s);
+
+void ss_store(GameState* gs, SaveState* ss) {
+    memset(ss, 0, sizeof(SaveState));
+    ss->magic = SS_MAGIC;
+    ss->version = SS_VERSION;
+    ss->size = sizeof(SaveState);
+    ss->tick = gs->tick;
+    ss->phase = gs->phase;
+    ss->spd_mod = gs->spd_mod;
+    ss->acc = (int32_t) gs->acc;
+    ss->elapsed = (int32_t) (gs->prev - gs->start);
+    ss->delay = (int32_t) gs->delay;
+    ss->level = gs->level;
+    ss->high = gs->high;
+    ss->score = gs->score;
+    ss->gain = gs->gain;
+    ss->energy = gs->energy;
+    ss->lives = gs->lives;
+    ss->to_clear = gs->to_clear;
+    ss->scene = gs->scene;
+    ss->n_sprites = (uint8_t) gs->n_sprites;
+    ss->n_doomed = gs->n_doomed;
+    ss->n_pending = gs->n_pending;
+    ss->los = gs->los;
+    ss->swapped = gs->swapped;
+    ss->wraps = gs->wraps;
+    ss->adj[0] = gs->adj_a.front;
+    ss->adj[1] = gs->adj_a.back;
+    ss->adj[2] = gs->adj_a.next;
+    ss->adj[3] = gs->adj_m.front;
+    ss->adj[4] = gs->adj_m.back;
+    ss->adj[5] = gs->adj_m.next;
+    ss->next_p[0] = gs->adj_a.next_p.x;
+    ss->next_p[1] = gs->adj_a.next_p.y;
+    ss->next_p[2] = gs->adj_m.next_p.x;
+    ss->next_p[3] = gs->adj_m.next_p.y;
+    memcpy(ss->doomed, gs->doomed, sizeof(ss->doomed));
+    memcpy(ss->walls, gs->walls, sizeof(ss->walls));
+
+    for (uint8_t i = 0; i < gs->n_pending; i++) {
+        ss->pending[2 * i] = gs->pending[i].x;
+        ss->pending[2 * i + 1] = gs->pending[i].y;
+    }
+
+    for (uint32_t i = 0; i < gs->n_sprites; i++) {
+        Sprite* s = &gs->sprites[i];
+        ss->sprites[i] = (SavedSprite) { s->p.x, s->p.y, s->d.x, s->d.y, s->flags, s->tile };
+    }
+}
+
+const SaveState* ss_view(const void* buf, size_t len) {
+    const SaveState* ss = buf;
+
+    if (buf == NULL || len < sizeof(SaveState) || (uintptr_t) buf % _Alignof(SaveState) != 0) {
+        return NULL;
+    }
+
+    if (ss->magic != SS_MAGIC || ss->version != SS_VERSION || ss->size != sizeof(SaveState)) {
+        return NULL;
+    }
+
+    return ss;
+}
+
+bool ss_load(GameState* gs, const SaveState* ss) {
+    if (ss->n_sprites < 3 || ss->n_sprites > MAX_SPRITES || ss->n_doomed > MAX_DOOMED ||
+            ss->n_pending > MAX_PENDING || ss->level < 0 || ss->level >= MAX_LEVEL || ss->scene >= SC_COUNT ||
+            !valid_point(ss->next_p[0], ss->next_p[1]) || !valid_point(ss->next_p[2], ss->next_p[3])) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < ss->n_sprites; i++) {
+        if (!valid_sprite(&ss->sprites[i])) {
+            return false;
+        }
+    }
+
+    for (uint8_t i = 0; i < ss->n_pending; i++) {
+        if (!valid_delta(ss->pending[2 * i], ss->pending[2 * i + 1])) {
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < sizeof(ss->walls); i++) {
+        if (ss->walls[i] != 0 && (ss->walls[i] < WALL_TILE_BASE || ss->walls[i] >= SS_TILES)) {
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < sizeof(ss->adj); i++) {
+        if (!valid_slot(ss, ss->adj[i])) {
+            return false;
+        }
+    }
+
+    for (uint8_t i = 0; i < ss->n_doomed; i++) {
+        if (!valid_slot(ss, ss->doomed[i]) || ss->doomed[i] == WALL_SLOT) {
+            return false;
+        }
+    }
+
+    gs->tick = ss->tick;
+    gs->phase = ss->phase;
+    gs->spd_mod = ss->spd_mod;
+    gs->acc = ss->acc;
+    gs->start = gs->prev - ss->elapsed;
+    gs->delay = ss->delay;
+    gs->level = ss->level;
+    gs->high = ss->high;
+    gs->score = ss->score;
+    gs->gain = ss->gain;
+    gs->energy = ss->energy;
+    gs->lives = ss->lives;
+    gs->to_clear = ss->to_clear;
+    gs->scene = ss->scene;
+    gs->n_sprites = ss->n_sprites;
+    gs->n_doomed = ss->n_doomed;
+    gs->n_pending = ss->n_pending;
+    gs->los = ss->los;
+    gs->swapped = ss->swapped;
+    gs->wraps = ss->wraps;
+    gs->adj_a = (Adjacent) { ss->adj[0], ss->adj[1], ss->adj[2], { ss->next_p[0], ss->next_p[1] } };
+    gs->adj_m = (Adjacent) { ss->adj[3], ss->adj[4], ss->adj[5], { ss->next_p[2], ss->next_p[3] } };
+    memcpy(gs->doomed, ss->doomed, sizeof(gs->doomed));
+    memcpy(gs->walls, ss->walls, sizeof(gs->walls));
+
+    for (uint8_t i = 0; i < ss->n_pending; i++) {
+        gs->pending[i] = (Delta) { ss->pending[2 * i], ss->pending[2 * i + 1] };
+    }
+
+    for (uint32_t i = 0; i < ss->n_sprites; i++) {
+        const SavedSprite* s = &ss->sprites[i];
+        gs->sprites[i] = (Sprite) { { s->x, s->y }, { s->dx, s->dy }, s->flags, s->tile };
+    }
+
+    gs_reindex(gs);
+    return true;
+}
+
+static bool valid_slot(const SaveState* ss, uint8_t slot) {
+    return slot < ss->n_sprites || slot == WALL_SLOT;
+}
+
+static bool valid_point(int16_t x, int16_t y) {
+    return (x == -1 && y == -1) || (x >= 0 && x < MAX_X && y >= 0 && y < MAX_Y);
+}
+
+static bool valid_delta(int8_t dx, int8_t dy) {
+    return dx >= -1 && dx <= 1 && dy >= -1 && dy <= 1;
+}
+
+static bool valid_sprite(const SavedSprite* s) {
+    bool placed = s->x >= 0 || (s->flags & F_NIL) != 0;
+    return valid_point(s->x, s->y) && placed && valid_delta(s->dx, s->dy) &&
+        (s->flags & ~SS_FLAGS) == 0 && s->tile < SS_TILES;
+}
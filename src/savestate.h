@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stddef.h>
+#include "gamestate.h"
+
+#define SS_MAGIC 0x53534d41u
+#define SS_VERSION 1
+
+typedef struct {
+    int16_t x;
+    int16_t y;
+    int8_t dx;
+    int8_t dy;
+    uint8_t flags;
+    uint8_t tile;
+} SavedSprite;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;
+    uint32_t tick;
+    int32_t phase;
+    int32_t spd_mod;
+    int32_t acc;
+    int32_t elapsed;
+    int32_t delay;
+    int32_t level;
+    int32_t high;
+    int32_t score;
+    int32_t gain;
+    int32_t energy;
+    int32_t lives;
+    int32_t to_clear;
+    int16_t next_p[4];
+    uint8_t scene;
+    uint8_t n_sprites;
+    uint8_t n_doomed;
+    uint8_t n_pending;
+    uint8_t los;
+    uint8_t swapped;
+    uint8_t wraps;
+    uint8_t adj[6];
+    uint8_t doomed[MAX_DOOMED];
+    int8_t pending[MAX_PENDING * 2];
+    uint8_t walls[MAP_W * MAP_H];
+    uint8_t reserved[6];
+    SavedSprite sprites[MAX_SPRITES];
+} SaveState;
+
+void ss_store(GameState* gs, SaveState* ss);
+const SaveState* ss_view(const void* buf, size_t len);
+bool ss_load(GameState* gs, const SaveState* ss);
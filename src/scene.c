@@ -1,10 +1,138 @@
 #include <stdio.h>
+#include "render.h"
 #include "scene.h"
+#include "savestate.h"
 #include "sprite.h"
+#include "undo.h"
 
 static void render_title(Backend* be, int x0, int y);
-static void fade_effect(Backend* be, float phase);
+static void fade_effect(Backend* be, int32_t phase);
 static void lose_life(GameState* gs, Backend* be);
+static void on_game_event(void* ctx, GameState* gs, GameEvent ev);
+static void save_state(GameState* gs, Backend* be);
+static void draw_splash(GameState* gs, Backend* be);
+static void draw_title_anim(GameState* gs, Backend* be);
+static void draw_title_move(GameState* gs, Backend* be);
+static void draw_title(GameState* gs, Backend* be);
+static void draw_fade_out(GameState* gs, Backend* be);
+static void draw_start_level(GameState* gs, Backend* be);
+static void draw_board(GameState* gs, Backend* be);
+static void draw_paused(GameState* gs, Backend* be);
+static void draw_death2(GameState* gs, Backend* be);
+static void draw_game_over(GameState* gs, Backend* be);
+
+static SceneFn* const SCENES[] = {
+    [SC_SPLASH] = sc_splash,
+    [SC_TITLE_ANIM] = sc_title_anim,
+    [SC_TITLE_MOVE] = sc_title_move,
+    [SC_TITLE] = sc_title,
+    [SC_FADE_OUT] = sc_fade_out,
+    [SC_START_LEVEL] = sc_start_level,
+    [SC_PLAYING] = sc_playing,
+    [SC_PAUSED] = sc_paused,
+    [SC_WAIT] = sc_wait,
+    [SC_SWAP] = sc_swap,
+    [SC_LEVEL_CLEAR] = sc_level_clear,
+    [SC_CLEAR_WAIT] = sc_clear_wait,
+    [SC_DEATH1] = sc_death1,
+    [SC_DEATH2] = sc_death2,
+    [SC_GAME_OVER] = sc_game_over,
+};
+
+static DrawFn* const DRAWS[] = {
+    [SC_SPLASH] = draw_splash,
+    [SC_TITLE_ANIM] = draw_title_anim,
+    [SC_TITLE_MOVE] = draw_title_move,
+    [SC_TITLE] = draw_title,
+    [SC_FADE_OUT] = draw_fade_out,
+    [SC_START_LEVEL] = draw_start_level,
+    [SC_PLAYING] = draw_board,
+    [SC_PAUSED] = draw_paused,
+    [SC_WAIT] = draw_board,
+    [SC_SWAP] = draw_board,
+    [SC_LEVEL_CLEAR] = draw_board,
+    [SC_CLEAR_WAIT] = draw_board,
+    [SC_DEATH1] = draw_board,
+    [SC_DEATH2] = draw_death2,
+    [SC_GAME_OVER] = draw_game_over,
+};
+
+void sc_init(Backend* be) {
+    be->undo = ud_init(UNDO_DEPTH);
+}
+
+void sc_quit(Backend* be) {
+    if (be->undo != NULL) {
+        ud_quit(be->undo);
+        be->undo = NULL;
+    }
+}
+
+bool sc_resume(GameState* gs, Backend* be) {
+    SaveState ss;
+    const SaveState* view = ss_view(&ss, be_load_state(be, &ss, sizeof(ss)));
+
+    if (view == NULL || !ss_load(gs, view)) {
+        return false;
+    }
+
+    if (gs->scene == SC_PLAYING) {
+        be_send_audiomsg(be, MSG_PLAY | 3);
+    }
+
+    return true;
+}
+
+void sc_keyframe(GameState* gs, Backend* be) {
+    SaveState ss;
+    ss_store(gs, &ss);
+    be_save_keyframe(be, &ss);
+}
+
+bool sc_restore(GameState* gs, Backend* be, const Keyframe* kf) {
+    if (be->undo == NULL || kf->undo_len + kf->undo_redo > be->undo->cap || !ss_load(gs, &kf->state)) {
+        return false;
+    }
+
+    ud_import(be->undo, (const UndoEntry*) (kf + 1), kf->undo_len, kf->undo_redo);
+    return true;
+}
+
+bool gs_update(GameState* gs, Backend* be, double timestamp) {
+    uint32_t ticks = gs_advance_clock(gs, timestamp);
+    bool retval = true;
+
+    for (uint32_t i = 0; i < ticks && retval; i++) {
+        gs_tick(gs);
+        retval = SCENES[gs->scene](gs, be);
+        be_record_hash(be, gs->tick, gs_hash(gs));
+
+        if (gs->tick % SAVE_TICKS == 0) {
+            save_state(gs, be);
+        }
+
+        if (gs->tick % KEYFRAME_TICKS == 0) {
+            sc_keyframe(gs, be);
+        }
+    }
+
+    if (ticks > 0) {
+        be_clear(be);
+        DRAWS[gs->scene](gs, be);
+        be_present(be);
+    }
+
+    return retval;
+}
+
+void gs_limit_fps(GameState* self) {
+    int64_t next = self->clock + MS_PER_FRAME;
+    int64_t now = (int64_t) be_get_millis();
+
+    if (next > now) {
+        be_delay(next - now);
+    }
+}
 
 static void render_title(Backend* be, int x0, int y) {
     for (int i = 0; i < 8; i++) {
@@ -13,8 +141,28 @@ static void render_title(Backend* be, int x0, int y) {
     }
 }
 
-static void fade_effect(Backend* be, float phase) {
-    int m = (int) (192.0f / powf(2, phase * 7.0f));
+static void fade_effect(Backend* be, int32_t phase) {
+    // LIMIT[m - 1] is the last phase where 192 / 2^(7 * phase / PHASE_ONE) >= m, i.e. the largest integer p with
+    // m^PHASE_ONE * 2^(7 * p) <= 192^PHASE_ONE, found by binary search over p in 0..PHASE_ONE using exact big integers.
+    static const int16_t LIMIT[192] = {
+        10000, 9407, 8571, 7978, 7518, 7142, 6825, 6549, 6307, 6090, 5893, 5714, 5549, 5396, 5254, 5121,
+        4996, 4878, 4767, 4661, 4560, 4465, 4373, 4285, 4201, 4120, 4042, 3968, 3895, 3825, 3758, 3692,
+        3629, 3567, 3508, 3450, 3393, 3338, 3285, 3232, 3182, 3132, 3083, 3036, 2990, 2944, 2900, 2857,
+        2814, 2773, 2732, 2692, 2652, 2614, 2576, 2539, 2502, 2467, 2431, 2397, 2363, 2329, 2296, 2264,
+        2232, 2200, 2169, 2139, 2109, 2079, 2050, 2021, 1993, 1965, 1937, 1910, 1883, 1856, 1830, 1804,
+        1778, 1753, 1728, 1703, 1679, 1655, 1631, 1607, 1584, 1561, 1538, 1516, 1494, 1471, 1450, 1428,
+        1407, 1386, 1365, 1344, 1323, 1303, 1283, 1263, 1243, 1224, 1204, 1185, 1166, 1148, 1129, 1110,
+        1092, 1074, 1056, 1038, 1020, 1003, 985, 968, 951, 934, 917, 901, 884, 868, 851, 835,
+        819, 803, 787, 772, 756, 741, 725, 710, 695, 680, 665, 650, 636, 621, 607, 592,
+        578, 564, 550, 536, 522, 508, 495, 481, 467, 454, 441, 427, 414, 401, 388, 375,
+        362, 350, 337, 324, 312, 299, 287, 275, 262, 250, 238, 226, 214, 202, 191, 179,
+        167, 156, 144, 133, 121, 110, 98, 87, 76, 65, 54, 43, 32, 21, 10, 0,
+    };
+    int m = 192;
+
+    while (m > 1 && phase > LIMIT[m - 1]) {
+        m--;
+    }
 
     for (int i = 8; i < 184; i++) {
         if (i % m != 0) {
@@ -29,32 +177,53 @@ static void lose_life(GameState* gs, Backend* be) {
 
     if (gs->lives > 0) {
         gs_load_level(gs);
-        gs_set_scene(gs, sc_start_level, 2);
+        ud_clear(be->undo);
+        gs_set_scene(gs, SC_START_LEVEL, 2);
     } else {
-        gs_set_scene(gs, sc_game_over, 12);
+        gs_set_scene(gs, SC_GAME_OVER, 12);
         be_send_audiomsg(be, MSG_PLAY | 8);
     }
 }
 
-bool sc_splash(GameState* gs, Backend* be) {
-    float phase = gs_phase(gs);
-    int x0 = 88;
-    int y0 = 80;
+static void save_state(GameState* gs, Backend* be) {
+    SaveState ss;
+    ss_store(gs, &ss);
+    be_save_state(be, &ss, sizeof(ss));
+}
 
-    if (phase < 0.8f) {
-        if (phase > 0.4f) {
-            be_blit_text(be, x0 + 24, y0 - 8, "(Not)");
-        }
+static void on_game_event(void* ctx, GameState* gs, GameEvent ev) {
+    Backend* be = (Backend*) ctx;
 
-        be_blit_text(be, x0, y0,  "MSX  system");
-        be_blit_text(be, x0, y0 + 8, "version 1.0");
-        be_blit_text(be, x0 - 48, y0 + 24, "Copyright 2020 by mkfoo");
-    } else {
-        be_set_color(be, 1);
+    switch (ev) {
+        case GE_MOVE:
+            ud_record(be->undo, gs, gs->sprites[ID_MATTER].d.x, gs->sprites[ID_MATTER].d.y);
+            be_send_audiomsg(be, MSG_PLAY | 5);
+            break;
+        case GE_DESTROY:
+            gs_set_scene(gs, SC_WAIT, 1);
+            be_send_audiomsg(be, MSG_PLAY | 9);
+            break;
+        case GE_EXPLODE:
+            gs_set_scene(gs, SC_DEATH2, 2);
+            be_send_audiomsg(be, MSG_STOP);
+            be_send_audiomsg(be, MSG_PLAY | 7);
+            break;
+        case GE_EXHAUSTED:
+            gs_set_scene(gs, SC_DEATH1, 2);
+            be_send_audiomsg(be, MSG_STOP);
+            be_send_audiomsg(be, MSG_PLAY | 6);
+            break;
+        case GE_CLEAR:
+            gs_set_scene(gs, SC_LEVEL_CLEAR, 0);
+            be_send_audiomsg(be, MSG_STOP);
+            be_send_audiomsg(be, MSG_REPEAT | MSG_PLAY | 10);
+            break;
     }
+}
 
-    if (phase == 1.0f) {
-        gs_set_scene(gs, sc_title_anim, 2);
+bool sc_splash(GameState* gs, Backend* be) {
+    if (gs_phase(gs) == PHASE_ONE) {
+        gs_set_scene(gs, SC_TITLE_ANIM, 2);
         be_send_audiomsg(be, MSG_REPEAT | MSG_PLAY | 1);
     }
 
@@ -62,55 +231,29 @@ bool sc_splash(GameState* gs, Backend* be) {
 }
 
 bool sc_title_anim(GameState* gs, Backend* be) {
-    float phase = gs_phase(gs);
-    int x0 = 64;
-    int y0 = 88;
-
-    for (int i = 0; i < 8; i++) {
-        float x = (float) i * 8.0f * (1.0f - phase);
-        float y = (float) i * 16.0f * (1.0f - phase);
-        render_title(be, x0 + (int) x, y0 - (int) y);
-        render_title(be, x0 - (int) x, y0 + (int) y);
-    }
+    (void) be;
 
-    if (phase == 1.0f) {
-        gs_set_scene(gs, sc_title_move, 1);
+    if (gs_phase(gs) == PHASE_ONE) {
+        gs_set_scene(gs, SC_TITLE_MOVE, 1);
     }
 
     return true;
 }
 
 bool sc_title_move(GameState* gs, Backend* be) {
-    be_get_event(be);
-    float phase = gs_phase(gs);
-    int x0 = 64;
-    int y0 = 88;
-    int y = y0 - (int) (phase * 32.0f);
-
-    render_title(be, x0, y);
+    be_get_event(be, gs->tick);
 
-    if (phase == 1.0f) {
-        gs_set_scene(gs, sc_title, 0);
+    if (gs_phase(gs) == PHASE_ONE) {
+        gs_set_scene(gs, SC_TITLE, 0);
     }
 
     return true;
 }
 
 bool sc_title(GameState* gs, Backend* be) {
-    static char high[8];
-    snprintf(high, 8, "%7d", gs->high);
-    be_blit_text(be, 60, 24, "HIGH-SCORE");
-    be_blit_text(be, 60 + 88, 24, high);
-    be_blit_text(be, 72, 160, "(c) 2020 mkfoo");
-    render_title(be, 64, 56);
-
-    if (gs_phase(gs) > 0.25f) {
-        be_blit_text(be, 72, 112, "PUSH SPACE KEY");
-    }
-
-    switch(be_get_event(be)) {
+    switch(be_get_event(be, gs->tick)) {
         case KD_SPC:
-            gs_set_scene(gs, sc_fade_out, 2);
+            gs_set_scene(gs, SC_FADE_OUT, 2);
             be_send_audiomsg(be, MSG_MUTE);
             be_send_audiomsg(be, MSG_MUTE);
             break;
@@ -134,24 +277,20 @@ bool sc_title(GameState* gs, Backend* be) {
 }
 
 bool sc_fade_out(GameState* gs, Backend* be) {
-    be_get_event(be);
-    float phase = gs_phase(gs);
-    int x0 = 64;
-    int y0 = 56;
-    int y = y0 + (int) (phase * 64.0f);
-    if (y > 88) y = 88;
-    render_title(be, x0, y);
+    be_get_event(be, gs->tick);
+    int32_t phase = gs_phase(gs);
 
-    if (((int) (phase * 100.0f)) % 5 == 0) {
+    if (phase * 100 / PHASE_ONE % 5 == 0) {
         be_send_audiomsg(be, MSG_VOL_DOWN);
     }
 
-    if (phase == 1.0f) {
+    if (phase == PHASE_ONE) {
         gs->level = START_LEVEL;
         gs->lives = START_LIVES;
         gs->score = 0;
         gs_load_level(gs);
-        gs_set_scene(gs, sc_start_level, 2);
+        ud_clear(be->undo);
+        gs_set_scene(gs, SC_START_LEVEL, 2);
         be_send_audiomsg(be, MSG_STOP);
         be_send_audiomsg(be, MSG_MUTE);
     }
@@ -160,15 +299,11 @@ bool sc_fade_out(GameState* gs, Backend* be) {
 }
 
 bool sc_start_level(GameState* gs, Backend* be) {
-    be_get_event(be);
+    be_get_event(be, gs->tick);
     be_send_audiomsg(be, MSG_PLAY | 2);
-    gs_render_sprites(gs, be);
-    float phase = gs_phase(gs);
-    fade_effect(be, phase);
-    gs_render_default(gs, be);
 
-    if (phase == 1.0f) {
-        gs_set_scene(gs, sc_playing, 0);
+    if (gs_phase(gs) == PHASE_ONE) {
+        gs_set_scene(gs, SC_PLAYING, 0);
         be_send_audiomsg(be, MSG_STOP);
         be_send_audiomsg(be, MSG_PLAY | 3);
     }
@@ -177,32 +312,41 @@ bool sc_start_level(GameState* gs, Backend* be) {
 }
 
 bool sc_playing(GameState* gs, Backend* be) {
+    EventSink sink = { on_game_event, be };
     gs_adv_state(gs);
-    gs_render_sprites(gs, be);
-    gs_render_default(gs, be);
-    gs_post_update(gs, be);
+    gs_post_update(gs, &sink);
 
-    switch(be_get_event(be)) {
+    switch(be_get_event(be, gs->tick)) {
         case KD_UP:
-            gs_move_pcs(gs, be, 0, -1);
+            gs_move_pcs(gs, &sink, 0, -1);
             break;
         case KD_RIGHT:
-            gs_move_pcs(gs, be, 1, 0);
+            gs_move_pcs(gs, &sink, 1, 0);
             break;
         case KD_LEFT:
-            gs_move_pcs(gs, be, -1, 0);
+            gs_move_pcs(gs, &sink, -1, 0);
             break;
         case KD_DOWN:
-            gs_move_pcs(gs, be, 0, 1);
+            gs_move_pcs(gs, &sink, 0, 1);
             break;
         case KD_SPC:
-            gs_set_scene(gs, sc_swap, 1);
+            gs_set_scene(gs, SC_SWAP, 1);
             be_send_audiomsg(be, MSG_PLAY | 11);
             gs->sprites[ID_ANTI].tile += 4;
             gs->sprites[ID_MATTER].tile += 4;
             break;
+        case KD_F7:
+            if (ud_undo(be->undo, gs)) {
+                be_send_audiomsg(be, MSG_PLAY | 5);
+            }
+            break;
+        case KD_F8:
+            if (ud_redo(be->undo, gs)) {
+                be_send_audiomsg(be, MSG_PLAY | 5);
+            }
+            break;
         case KD_ESC:
-            gs_set_scene(gs, sc_paused, 0);
+            gs_set_scene(gs, SC_PAUSED, 0);
             be_send_audiomsg(be, MSG_STOP);
             be_send_audiomsg(be, MSG_PLAY | 4);
             break;
@@ -228,19 +372,16 @@ bool sc_playing(GameState* gs, Backend* be) {
 }
 
 bool sc_paused(GameState* gs, Backend* be) {
-    gs_render_help(gs, be);
-    gs_render_default(gs, be);
-
-    switch(be_get_event(be)) {
+    switch(be_get_event(be, gs->tick)) {
         case KD_SPC:
         case KD_ESC:
-            gs_set_scene(gs, sc_playing, 0);
+            gs_set_scene(gs, SC_PLAYING, 0);
             be_send_audiomsg(be, MSG_STOP);
             be_send_audiomsg(be, MSG_PLAY | 3);
             break;
         case KD_F1:
             gs->energy = 0;
-            gs_set_scene(gs, sc_playing, 0);
+            gs_set_scene(gs, SC_PLAYING, 0);
             break;
         case QUIT:
             return false;
@@ -252,93 +393,82 @@ bool sc_paused(GameState* gs, Backend* be) {
 }
 
 bool sc_wait(GameState* gs, Backend* be) {
-    be_get_event(be);
-    gs_render_sprites(gs, be);
-    gs_render_default(gs, be);
+    be_get_event(be, gs->tick);
 
-    if (gs_phase(gs) == 1.0f) {
-        gs_set_scene(gs, sc_playing, 0);
+    if (gs_phase(gs) == PHASE_ONE) {
+        gs_set_scene(gs, SC_PLAYING, 0);
     } 
 
     return true;
 }
 
 bool sc_swap(GameState* gs, Backend* be) {
-    be_get_event(be);
-    static bool swapped = false;
-    gs_render_sprites(gs, be);
-    gs_render_default(gs, be);
+    be_get_event(be, gs->tick);
 
-    if (gs_phase(gs) >= 0.5f && !swapped) {
+    if (gs_phase(gs) >= PHASE_ONE / 2 && !gs->swapped) {
         gs_swap_sprites(gs);
         gs->energy -= SWAP_COST;
-        gs->spd_mod = 8.0f;
-        swapped = true;
-    } else if (gs_phase(gs) == 1.0f) {
+        gs->spd_mod = 8;
+        gs->swapped = true;
+    } else if (gs_phase(gs) == PHASE_ONE) {
         gs->sprites[ID_ANTI].tile = 1;
         gs->sprites[ID_MATTER].tile = 9;
-        gs_set_scene(gs, sc_playing, 0);
-        gs->spd_mod = -8.0f;
-        swapped = false;
+        gs_set_scene(gs, SC_PLAYING, 0);
+        gs->spd_mod = -8;
+        gs->swapped = false;
     } 
 
     return true;
 }
 
 bool sc_level_clear(GameState* gs, Backend* be) {
-    static int32_t gain = 0;
-    gs->spd_mod = -12.0f;
-    be_get_event(be);
-    gs_render_sprites(gs, be);
-    gs_render_default(gs, be);
+    gs->spd_mod = -12;
+    be_get_event(be, gs->tick);
     gs->energy -= 4;
 
     if (gs->energy > 0) {
         gs_score(gs, CLEAR_BONUS);
-        gain += CLEAR_BONUS;
+        gs->gain += CLEAR_BONUS;
     } else {
         be_send_audiomsg(be, MSG_STOP);
         gs->energy = 0;
-        int32_t bonus = gs->score / BONUS_LIMIT - (gs->score - gain) / BONUS_LIMIT;
+        int32_t bonus = gs->score / BONUS_LIMIT - (gs->score - gs->gain) / BONUS_LIMIT;
 
         if (bonus > 0) {
             gs->lives += bonus;
             be_send_audiomsg(be, MSG_PLAY | 12);
         }
 
-        gs_set_scene(gs, sc_clear_wait, 2);
-        gain = 0;
+        gs_set_scene(gs, SC_CLEAR_WAIT, 2);
+        gs->gain = 0;
     }
 
     return true;
 }
 
 bool sc_clear_wait(GameState* gs, Backend* be) {
-    be_get_event(be);
-    gs_render_sprites(gs, be);
-    gs_render_default(gs, be);
+    be_get_event(be, gs->tick);
 
-    if (gs_phase(gs) == 1.0f) {
+    if (gs_phase(gs) == PHASE_ONE) {
         gs->level = (int16_t) (gs->level + 1) % MAX_LEVEL;
         gs_load_level(gs);
-        gs_set_scene(gs, sc_start_level, 2);
-        gs->spd_mod = -8.0f;
+        ud_clear(be->undo);
+        gs_set_scene(gs, SC_START_LEVEL, 2);
+        gs->spd_mod = -8;
     }
 
     return true;
 }
 
 bool sc_death1(GameState* gs, Backend* be) {
-    be_get_event(be);
-    gs_render_sprites(gs, be);
-    gs_render_default(gs, be);
+    be_get_event(be, gs->tick);
 
-    if (gs_phase(gs) > 0.6f) {
+    if (gs_phase(gs) > PHASE_ONE * 3 / 5) {
         gs->sprites[ID_ANTI].flags |= F_NIL;
         gs->sprites[ID_MATTER].flags |= F_NIL;
     }
 
-    if (gs_phase(gs) == 1.0f) {
+    if (gs_phase(gs) == PHASE_ONE) {
         lose_life(gs, be);
     }
 
@@ -346,22 +476,9 @@ bool sc_death1(GameState* gs, Backend* be) {
 }
 
 bool sc_death2(GameState* gs, Backend* be) {
-    be_get_event(be);
-    float phase = gs_phase(gs);
+    be_get_event(be, gs->tick);
 
-    if (phase > 0.08f && phase < 0.5f) {
-        be_set_color(be, 15);
-    } else if (phase < 0.8f) {
-        be_set_color(be, 14);
-    } else {
-        be_set_color(be, 1);
-    }
-
-    gs_render_sprites(gs, be);
-    fade_effect(be, 1.0f - phase);
-    gs_render_default(gs, be);
-
-    if (phase == 1.0f) {
+    if (gs_phase(gs) == PHASE_ONE) {
         lose_life(gs, be);
     }
 
@@ -369,16 +486,110 @@ bool sc_death2(GameState* gs, Backend* be) {
 }
 
 bool sc_game_over(GameState* gs, Backend* be) {
-    be_get_event(be);
-    float phase = gs_phase(gs);
-    be_blit_text(be, 64, 92, "GAME OVER");
-    gs_render_default(gs, be);
+    be_get_event(be, gs->tick);
 
-    if (phase == 1.0f) {
-        gs_set_scene(gs, sc_title_anim, 2);
+    if (gs_phase(gs) == PHASE_ONE) {
+        gs_set_scene(gs, SC_TITLE_ANIM, 2);
         be_send_audiomsg(be, MSG_STOP);
         be_send_audiomsg(be, MSG_REPEAT | MSG_PLAY | 1);
     }
 
     return true;
 }
+
+static void draw_splash(GameState* gs, Backend* be) {
+    int32_t phase = gs_phase(gs);
+    int x0 = 88;
+    int y0 = 80;
+
+    if (phase < PHASE_ONE * 4 / 5) {
+        if (phase > PHASE_ONE * 2 / 5) {
+            be_blit_text(be, x0 + 24, y0 - 8, "(Not)");
+        }
+
+        be_blit_text(be, x0, y0,  "MSX  system");
+        be_blit_text(be, x0, y0 + 8, "version 1.0");
+        be_blit_text(be, x0 - 48, y0 + 24, "Copyright 2020 by mkfoo");
+    } else {
+        be_set_color(be, 1);
+    }
+}
+
+static void draw_title_anim(GameState* gs, Backend* be) {
+    int32_t phase = gs_phase(gs);
+    int x0 = 64;
+    int y0 = 88;
+
+    for (int i = 0; i < 8; i++) {
+        int x = i * 8 * (PHASE_ONE - phase) / PHASE_ONE;
+        int y = i * 16 * (PHASE_ONE - phase) / PHASE_ONE;
+        render_title(be, x0 + x, y0 - y);
+        render_title(be, x0 - x, y0 + y);
+    }
+}
+
+static void draw_title_move(GameState* gs, Backend* be) {
+    int x0 = 64;
+    int y0 = 88;
+    int y = y0 - gs_phase(gs) * 32 / PHASE_ONE;
+
+    render_title(be, x0, y);
+}
+
+static void draw_title(GameState* gs, Backend* be) {
+    char high[8];
+    snprintf(high, 8, "%7d", gs->high);
+    be_blit_text(be, 60, 24, "HIGH-SCORE");
+    be_blit_text(be, 60 + 88, 24, high);
+    be_blit_text(be, 72, 160, "(c) 2020 mkfoo");
+    render_title(be, 64, 56);
+
+    if (gs_phase(gs) > PHASE_ONE / 4) {
+        be_blit_text(be, 72, 112, "PUSH SPACE KEY");
+    }
+}
+
+static void draw_fade_out(GameState* gs, Backend* be) {
+    int x0 = 64;
+    int y0 = 56;
+    int y = y0 + gs_phase(gs) * 64 / PHASE_ONE;
+    if (y > 88) y = 88;
+    render_title(be, x0, y);
+}
+
+static void draw_start_level(GameState* gs, Backend* be) {
+    gs_render_sprites(gs, be);
+    fade_effect(be, gs_phase(gs));
+    gs_render_default(gs, be);
+}
+
+static void draw_board(GameState* gs, Backend* be) {
+    gs_render_sprites(gs, be);
+    gs_render_default(gs, be);
+}
+
+static void draw_paused(GameState* gs, Backend* be) {
+    gs_render_help(gs, be);
+    gs_render_default(gs, be);
+}
+
+static void draw_death2(GameState* gs, Backend* be) {
+    int32_t phase = gs_phase(gs);
+
+    if (phase > PHASE_ONE * 2 / 25 && phase < PHASE_ONE / 2) {
+        be_set_color(be, 15);
+    } else if (phase < PHASE_ONE * 4 / 5) {
+        be_set_color(be, 14);
+    } else {
+        be_set_color(be, 1);
+    }
+
+    gs_render_sprites(gs, be);
+    fade_effect(be, PHASE_ONE - phase);
+    gs_render_default(gs, be);
+}
+
+static void draw_game_over(GameState* gs, Backend* be) {
+    be_blit_text(be, 64, 92, "GAME OVER");
+    gs_render_default(gs, be);
+}
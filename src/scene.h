@@ -1,5 +1,19 @@
+#pragma once
+
+#include "backend.h"
 #include "gamestate.h"
 
+typedef bool SceneFn(GameState* gs, Backend* be);
+typedef void DrawFn(GameState* gs, Backend* be);
+
+void sc_init(Backend* be);
+void sc_quit(Backend* be);
+bool sc_resume(GameState* gs, Backend* be);
+void sc_keyframe(GameState* gs, Backend* be);
+bool sc_restore(GameState* gs, Backend* be, const Keyframe* kf);
+bool gs_update(GameState* gs, Backend* be, double timestamp);
+void gs_limit_fps(GameState* gs);
+
 bool sc_splash(GameState* gs, Backend* be);
 bool sc_title_anim(GameState* gs, Backend* be);
 bool sc_title_move(GameState* gs, Backend* be);
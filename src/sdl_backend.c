@@ -1,7 +1,13 @@
+#include <string.h>
 #include "backend.h"
 #include "texture_data.h"
 
+#ifndef BUILD_HASH
+#define BUILD_HASH 0
+#endif
+
 void am_audio_callback(void* userdata, uint8_t* stream, int len);
+static Event be_poll_event(Backend* be);
 static Event be_get_keydown(Backend* be, SDL_Keycode key);
 static void be_toggle_fullscreen(Backend* be);
 static void be_toggle_scale(Backend* be);
@@ -33,6 +39,29 @@ Backend* be_init(void) {
     Backend* be = calloc(1, sizeof(Backend));
     LOG_ERR(be == NULL, "alloc failure");
 
+    char* hash_path = getenv("AM_HASH_LOG");
+
+    if (hash_path != NULL) {
+        be->hash_log = fopen(hash_path, "w");
+        LOG_ERR(be->hash_log == NULL, "cannot open hash log")
+    }
+
+    be->save_path = getenv("AM_SAVE_STATE");
+    char* replay_path = getenv("AM_RECORD");
+
+    if (replay_path != NULL) {
+        be->replay = fopen(replay_path, "wb");
+        LOG_ERR(be->replay == NULL, "cannot open replay file")
+        be->rp_hdr = (ReplayHeader) { .magic = RP_MAGIC, .version = RP_VERSION, .build = BUILD_HASH };
+#ifdef FIXED_STEP
+        be->rp_hdr.fixed = 1;
+#endif
+        err = fwrite(&be->rp_hdr, sizeof(ReplayHeader), 1, be->replay) != 1;
+        LOG_ERR(err, "cannot write replay file")
+        be->keyframes = rp_init();
+        LOG_ERR(be->keyframes == NULL, "alloc failure")
+    }
+
     err = SDL_Init(SDL_INIT_VIDEO | 
                    SDL_INIT_AUDIO | 
                    SDL_INIT_EVENTS);
@@ -107,11 +136,42 @@ void be_quit(Backend* be) {
     SDL_DestroyRenderer(be->ren);
     SDL_DestroyWindow(be->win);
     SDL_CloseAudioDevice(be->dev);
+
+    if (be->hash_log != NULL) {
+        fclose(be->hash_log);
+    }
+
+    if (be->replay != NULL) {
+        KeyframeLog* kl = be->keyframes;
+
+        if (fwrite(kl->index, sizeof(KeyframeRef), kl->len, be->replay) == kl->len &&
+                fwrite(kl->data, 1, kl->size, be->replay) == kl->size) {
+            be->rp_hdr.n_keyframes = kl->len;
+            be->rp_hdr.kf_size = kl->size;
+        }
+
+        rp_quit(kl);
+        rewind(be->replay);
+        fwrite(&be->rp_hdr, sizeof(ReplayHeader), 1, be->replay);
+        fclose(be->replay);
+    }
+
     SDL_free(be);
     SDL_Quit();
 }
 
-Event be_get_event(Backend* be) {
+Event be_get_event(Backend* be, uint32_t tick) {
+    Event ev = be_poll_event(be);
+
+    if (be->replay != NULL && ev != IDLE) {
+        ReplayInput input = { tick, ev };
+        be->rp_hdr.n_inputs += (uint32_t) fwrite(&input, sizeof(ReplayInput), 1, be->replay);
+    }
+
+    return ev;
+}
+
+static Event be_poll_event(Backend* be) {
     SDL_Event e;
 
     while (SDL_PollEvent(&e)) {
@@ -157,6 +217,10 @@ static Event be_get_keydown(Backend* be, SDL_Keycode key) {
             return KD_F5;
         case SDLK_F6:
             return KD_F6;
+        case SDLK_F7:
+            return KD_F7;
+        case SDLK_F8:
+            return KD_F8;
         default:
             return IDLE;
     }
@@ -215,6 +279,63 @@ void be_send_audiomsg(Backend* be, int msg) {
     SDL_UnlockAudioDevice(be->dev);
 }
 
+void be_record_hash(Backend* be, uint32_t tick, uint64_t hash) {
+    if (be->hash_log != NULL) {
+        fprintf(be->hash_log, "%u %016llx\n", tick, (unsigned long long) hash);
+    }
+
+    if (be->replay != NULL) {
+        be->rp_hdr.end_tick = tick;
+        be->rp_hdr.end_hash = hash;
+    }
+}
+
+void be_save_state(Backend* be, const void* buf, size_t len) {
+    if (be->save_path == NULL) {
+        return;
+    }
+
+    char tmp_path[BUF_LEN];
+    snprintf(tmp_path, BUF_LEN, "%s.tmp", be->save_path);
+    FILE* file = fopen(tmp_path, "wb");
+
+    if (file != NULL) {
+        size_t count = fwrite(buf, 1, len, file);
+
+        if (!fclose(file) && count == len) {
+            rename(tmp_path, be->save_path);
+        }
+    }
+}
+
+size_t be_load_state(Backend* be, void* buf, size_t cap) {
+    if (be->save_path == NULL) {
+        return 0;
+    }
+
+    FILE* file = fopen(be->save_path, "rb");
+
+    if (file == NULL) {
+        return 0;
+    }
+
+    size_t count = fread(buf, 1, cap, file);
+    fclose(file);
+
+    if (be->replay != NULL && count > 0) {
+        be->rp_hdr.start_len = (uint32_t) (count < sizeof(SaveState) ? count : sizeof(SaveState));
+        memcpy(&be->rp_hdr.start, buf, be->rp_hdr.start_len);
+    }
+
+    return count;
+}
+
+void be_save_keyframe(Backend* be, const SaveState* ss) {
+    if (be->keyframes != NULL) {
+        rp_add_keyframe(be->keyframes, ss, be->undo);
+    }
+}
+
 void be_draw_line(Backend* be, int x1, int y1, int x2, int y2) {
     SDL_RenderDrawLine(be->ren, x1, y1, x2, y2);
 }
@@ -4,8 +4,6 @@
 
 static bool should_stop(Sprite* self);
 static bool num_between(int16_t self, int16_t a, int16_t b);
-static bool opp_polarity(Sprite* self, Sprite* other);
-static bool is_identical(Sprite* self, Sprite* other);
 
 Delta get_delta(Sprite* self, Sprite* other) {
     int16_t x = other->p.x - self->p.x; 
@@ -75,34 +73,28 @@ bool point_between(Point self, Point p1, Point p2) {
     return false;
 }
 
-bool can_move(Adjacent* a) {
-    return has_flag(a->front, F_NIL) || 
-        (has_flag(a->front, F_MOVABLE) && 
-            (has_flag(a->next, F_NIL) || 
-                (has_flag(a->next, F_MOVABLE) && 
-                    opp_polarity(a->front, a->next))));
-}
-
-bool can_move_both(Adjacent* a, Adjacent* b) {
-    return (can_move(a) && can_move(b)) &&
-            !is_identical(a->front, b->next) && 
-                !is_identical(b->front, a->next) && 
-                    (!point_equals(a->next_p, b->next_p) || 
-                        (opp_polarity(a->front, b->front) ||
-                            (has_flag(a->front, F_NIL) ||
-                                has_flag(b->front, F_NIL))));
+bool can_move(Sprite* front, Sprite* next) {
+    return has_flag(front, F_NIL) || 
+        (has_flag(front, F_MOVABLE) && 
+            (has_flag(next, F_NIL) || 
+                (has_flag(next, F_MOVABLE) && 
+                    opp_polarity(front, next))));
 }
 
 bool can_pull(Sprite* self, Sprite* other) {
     return has_flag(other, F_MOVABLE) && opp_polarity(self, other);
 }
 
-void move_sprite(Sprite* self, Adjacent* a, Delta d) {
+bool opp_polarity(Sprite* self, Sprite* other) {
+    return has_flag(self, F_POLARITY) ^ has_flag(other, F_POLARITY);
+}
+
+void move_sprite(Sprite* self, Sprite* front, Sprite* back, Delta d) {
     self->d = d;
-    push_sprite(a->front, d);
+    push_sprite(front, d);
 
-    if (can_pull(self, a->back)) {
-        push_sprite(a->back, d);
+    if (can_pull(self, back)) {
+        push_sprite(back, d);
     }
 }
 
@@ -113,13 +105,51 @@ void push_sprite(Sprite* self, Delta d) {
 }
 
 void update_sprite(Sprite* self) {
-    self->p = calc_point(self->p, self->d); 
+    advance_sprite(self, 1);
+}
+
+void advance_sprite(Sprite* self, int8_t n) {
+    Delta d = { (int8_t) (self->d.x * n), (int8_t) (self->d.y * n) };
+    self->p = calc_point(self->p, d); 
+
+    if (should_stop(self)) {
+        self->d = (Delta) { 0, 0 };
+    } 
+}
+
+void advance_sprite_nowrap(Sprite* self, int8_t n) {
+    int16_t x = (int16_t) (self->p.x + self->d.x * n);
+    int16_t y = (int16_t) (self->p.y + self->d.y * n);
+
+    if (x < 0 || x >= MAX_X || y < 0 || y >= MAX_Y) {
+        advance_sprite(self, n);
+        return;
+    }
+
+    self->p = (Point) { x, y };
 
     if (should_stop(self)) {
         self->d = (Delta) { 0, 0 };
     } 
 }
 
+int16_t steps_to_stop(Sprite* self) {
+    int16_t n = INT16_MAX;
+
+    if (self->d.x != 0) {
+        int16_t r = self->p.x % TILE_W;
+        n = self->d.x > 0 ? TILE_W - r : (r ? r : TILE_W);
+    }
+
+    if (self->d.y != 0) {
+        int16_t r = self->p.y % TILE_H;
+        int16_t ny = self->d.y > 0 ? TILE_H - r : (r ? r : TILE_H);
+        n = ny < n ? ny : n;
+    }
+
+    return n;
+}
+
 void destroy_sprite(Sprite* self) {
     if (!has_flag(self, F_DESTROY)) {
         self->flags |= F_DESTROY;
@@ -146,11 +176,3 @@ static bool num_between(int16_t self, int16_t a, int16_t b) {
 
     return false;
 }
-
-static bool opp_polarity(Sprite* self, Sprite* other) {
-    return has_flag(self, F_POLARITY) ^ has_flag(other, F_POLARITY);
-}
-
-static bool is_identical(Sprite* self, Sprite* other) {
-    return self == other && !has_flag(self, F_NIL);
-}
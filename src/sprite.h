@@ -42,9 +42,9 @@ typedef enum {
 } SpriteId;
 
 typedef struct {
-    Sprite* front;
-    Sprite* back;
-    Sprite* next;
+    uint8_t front;
+    uint8_t back;
+    uint8_t next;
     Point next_p;
 } Adjacent;
 
@@ -58,10 +58,13 @@ bool is_aligned(Sprite* self);
 bool is_overlapping(Sprite* self, Sprite* other);
 bool point_equals(Point p1, Point p2);
 bool point_between(Point self, Point p1, Point p2);
-bool can_move(Adjacent* a); 
-bool can_move_both(Adjacent* a, Adjacent* b); 
+bool can_move(Sprite* front, Sprite* next); 
 bool can_pull(Sprite* self, Sprite* other);
-void move_sprite(Sprite* self, Adjacent* a, Delta d);
+bool opp_polarity(Sprite* self, Sprite* other);
+void move_sprite(Sprite* self, Sprite* front, Sprite* back, Delta d);
 void push_sprite(Sprite* self, Delta d);
 void update_sprite(Sprite* self);
+void advance_sprite(Sprite* self, int8_t n);
+void advance_sprite_nowrap(Sprite* self, int8_t n);
+int16_t steps_to_stop(Sprite* self);
 void destroy_sprite(Sprite* self);
@@ -0,0 +1,175 @@
+#include <stdlib.h>
+#include <string.h>
+#include "undo.h"
+
+static void add_adjacent(UndoEntry* e, GameState* gs, Adjacent* adj);
+static void add_piece(UndoEntry* e, GameState* gs, Sprite* s);
+static uint8_t find_piece(GameState* gs, Point p, uint8_t* claimed, uint8_t n);
+static Point piece_point(UndoPiece* pc);
+
+UndoLog* ud_init(uint32_t cap) {
+    UndoLog* ud = calloc(1, sizeof(UndoLog));
+    LOG_ERR(ud == NULL, "alloc failure")
+    ud->entries = calloc(cap, sizeof(UndoEntry));
+    LOG_ERR(ud->entries == NULL, "alloc failure")
+    ud->cap = cap;
+    return ud;
+}
+
+void ud_record(UndoLog* ud, GameState* gs, int8_t dx, int8_t dy) {
+    if (ud == NULL || ud->cap == 0) {
+        return;
+    }
+
+    if (ud->len == ud->cap) {
+        ud->head = (ud->head + 1) % ud->cap;
+        ud->len--;
+    }
+
+    UndoEntry* e = &ud->entries[(ud->head + ud->len) % ud->cap];
+    e->energy = gs->energy;
+    e->score = gs->score;
+    e->to_clear = (int16_t) gs->to_clear;
+    e->dx = dx;
+    e->dy = dy;
+    e->n = 0;
+    add_piece(e, gs, &gs->sprites[ID_ANTI]);
+    add_piece(e, gs, &gs->sprites[ID_MATTER]);
+    add_adjacent(e, gs, &gs->adj_a);
+    add_adjacent(e, gs, &gs->adj_m);
+    ud->len++;
+    ud->redo = 0;
+}
+
+bool ud_undo(UndoLog* ud, GameState* gs) {
+    if (ud == NULL || ud->len == 0 || is_moving(&gs->sprites[ID_ANTI])) {
+        return false;
+    }
+
+    UndoEntry* e = &ud->entries[(ud->head + ud->len - 1) % ud->cap];
+    uint8_t slots[UNDO_PIECES];
+
+    for (uint8_t i = 0; i < e->n; i++) {
+        UndoPiece* pc = &e->pcs[i];
+        Delta d = { (int8_t) ((pc->code >> 3 & 3) - 1), (int8_t) ((pc->code >> 5 & 3) - 1) };
+        Point p = calc_tile(piece_point(pc), d);
+        slots[i] = pc->slot < 3 ? pc->slot : find_piece(gs, p, slots, i);
+    }
+
+    for (uint8_t i = 0; i < e->n; i++) {
+        if (slots[i] != ID_NIL) {
+            gs_put_sprite(gs, slots[i], e->pcs[i].code & 7, piece_point(&e->pcs[i]));
+        }
+    }
+
+    for (uint8_t slot = 3; slot < MAX_SPRITES; slot++) {
+        for (uint8_t i = 0; i < e->n; i++) {
+            if (slots[i] == ID_NIL && e->pcs[i].slot == slot) {
+                gs_insert_sprite(gs, slot, e->pcs[i].code & 7, piece_point(&e->pcs[i]));
+            }
+        }
+    }
+
+    gs->adj_a = (Adjacent) { ID_NIL, ID_NIL, ID_NIL, { 0, 0 } };
+    gs->adj_m = (Adjacent) { ID_NIL, ID_NIL, ID_NIL, { -1, -1 } };
+    gs->energy = e->energy;
+    gs->score = e->score;
+    gs->to_clear = e->to_clear;
+    gs->los = false;
+    gs->n_pending = 0;
+    ud->len--;
+    ud->redo++;
+    return true;
+}
+
+bool ud_redo(UndoLog* ud, GameState* gs) {
+    if (ud == NULL || ud->redo == 0) {
+        return false;
+    }
+
+    UndoEntry* e = &ud->entries[(ud->head + ud->len) % ud->cap];
+    uint32_t redo = ud->redo;
+
+    if (!gs_start_move(gs, NULL, e->dx, e->dy)) {
+        return false;
+    }
+
+    ud_record(ud, gs, e->dx, e->dy);
+    ud->redo = redo - 1;
+    return true;
+}
+
+void ud_clear(UndoLog* ud) {
+    if (ud != NULL) {
+        ud->head = 0;
+        ud->len = 0;
+        ud->redo = 0;
+    }
+}
+
+void ud_export(UndoLog* ud, UndoEntry* out) {
+    for (uint32_t i = 0; i < ud->len + ud->redo; i++) {
+        out[i] = ud->entries[(ud->head + i) % ud->cap];
+    }
+}
+
+void ud_import(UndoLog* ud, const UndoEntry* in, uint32_t len, uint32_t redo) {
+    memcpy(ud->entries, in, (len + redo) * sizeof(UndoEntry));
+    ud->head = 0;
+    ud->len = len;
+    ud->redo = redo;
+}
+
+void ud_quit(UndoLog* ud) {
+    free(ud->entries);
+    free(ud);
+}
+
+static void add_adjacent(UndoEntry* e, GameState* gs, Adjacent* adj) {
+    Sprite* front = gs_sprite(gs, adj->front);
+    Sprite* back = gs_sprite(gs, adj->back);
+    add_piece(e, gs, front);
+
+    if (is_moving(front)) {
+        add_piece(e, gs, gs_sprite(gs, adj->next));
+    }
+
+    if (is_moving(back)) {
+        add_piece(e, gs, back);
+    }
+}
+
+static void add_piece(UndoEntry* e, GameState* gs, Sprite* s) {
+    if (!has_flag(s, F_MOVABLE) && !has_flag(s, F_PLAYER_CHAR)) {
+        return;
+    }
+
+    uint8_t cell = (uint8_t) (s->p.y / TILE_H * MAP_W + s->p.x / TILE_W);
+
+    for (uint8_t i = 0; i < e->n; i++) {
+        if (e->pcs[i].cell == cell) {
+            return;
+        }
+    }
+
+    int id = has_flag(s, F_PLAYER_CHAR) ? ID_ANTI : ID_BLOB_B + 2 * has_flag(s, F_UNSTABLE);
+    id += has_flag(s, F_POLARITY);
+    uint8_t code = (uint8_t) (id | (s->d.x + 1) << 3 | (s->d.y + 1) << 5);
+    e->pcs[e->n++] = (UndoPiece) { cell, code, (uint8_t) (s - gs->sprites) };
+}
+
+static uint8_t find_piece(GameState* gs, Point p, uint8_t* claimed, uint8_t n) {
+    int cell = p.y / TILE_H * MAP_W + p.x / TILE_W;
+
+    for (uint8_t i = gs->grid[cell]; i != ID_NIL; i = gs->grid_next[i]) {
+        if (i >= 3 && point_equals(gs->sprites[i].p, p) && memchr(claimed, i, n) == NULL) {
+            return i;
+        }
+    }
+
+    return ID_NIL;
+}
+
+static Point piece_point(UndoPiece* pc) {
+    return (Point) { (int16_t) (pc->cell % MAP_W * TILE_W), (int16_t) (pc->cell / MAP_W * TILE_H) };
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "gamestate.h"
+
+typedef struct {
+    uint8_t cell;
+    uint8_t code;
+    uint8_t slot;
+} UndoPiece;
+
+typedef struct {
+    int32_t energy;
+    int32_t score;
+    int16_t to_clear;
+    int8_t dx;
+    int8_t dy;
+    uint8_t n;
+    UndoPiece pcs[UNDO_PIECES];
+} UndoEntry;
+
+typedef struct {
+    uint32_t cap;
+    uint32_t head;
+    uint32_t len;
+    uint32_t redo;
+    UndoEntry* entries;
+} UndoLog;
+
+UndoLog* ud_init(uint32_t cap);
+void ud_record(UndoLog* ud, GameState* gs, int8_t dx, int8_t dy);
+bool ud_undo(UndoLog* ud, GameState* gs);
+bool ud_redo(UndoLog* ud, GameState* gs);
+void ud_clear(UndoLog* ud);
+void ud_export(UndoLog* ud, UndoEntry* out);
+void ud_import(UndoLog* ud, const UndoEntry* in, uint32_t len, uint32_t redo);
+void ud_quit(UndoLog* ud);
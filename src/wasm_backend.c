@@ -45,6 +45,15 @@ void wbe_toggle_scale_factor(void);
 __attribute__((import_name("wbe_send_audiomsg")))
 void wbe_send_audiomsg(int msg);
 
+__attribute__((import_name("wbe_record_hash")))
+void wbe_record_hash(uint32_t tick, uint32_t hi, uint32_t lo);
+
+__attribute__((import_name("wbe_save_state")))
+void wbe_save_state(const void* ptr, size_t len);
+
+__attribute__((import_name("wbe_load_state")))
+size_t wbe_load_state(void* ptr, size_t cap);
+
 static VertexBuf vb_init(size_t cap);
 static void vb_push(VertexBuf* self, int x, int y, int z, int w);
 static void vb_push_quad(VertexBuf* self, int dx, int dy, int sx, int sy, int w, int h);
@@ -104,7 +113,7 @@ Backend* be_init(void) {
     return be;
 }
 
-Event be_get_event(Backend* be) {
+Event be_get_event(Backend* be, uint32_t tick) {
     Event e = wbe_get_keydown(); 
 
     switch (e) {
@@ -128,6 +137,8 @@ void be_set_render_target(Backend* be, int tgt) {
 }
 
 void be_clear(Backend* be) {
+    be->sprites.len = 0;
+    be->lines.len = 0;
     wbe_clear();
 }
 
@@ -175,6 +186,21 @@ void be_send_audiomsg(Backend* be, int msg) {
    wbe_send_audiomsg(msg); 
 }
 
+void be_record_hash(Backend* be, uint32_t tick, uint64_t hash) {
+    wbe_record_hash(tick, (uint32_t) (hash >> 32), (uint32_t) hash);
+}
+
+void be_save_state(Backend* be, const void* buf, size_t len) {
+    wbe_save_state(buf, len);
+}
+
+size_t be_load_state(Backend* be, void* buf, size_t cap) {
+    return wbe_load_state(buf, cap);
+}
+
+void be_save_keyframe(Backend* be, const SaveState* ss) {
+}
+
 double be_get_millis(void) {
     return 1.0;
 }
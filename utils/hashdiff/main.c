@@ -0,0 +1,66 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+    uint32_t tick;
+    unsigned long long hash;
+} Entry;
+
+static FILE* open_log(const char* path);
+static bool read_entry(FILE* file, Entry* e);
+
+static FILE* open_log(const char* path) {
+    FILE* file = fopen(path, "r");
+
+    if (file == NULL) {
+        fprintf(stderr, "cannot open %s\n", path);
+        exit(2);
+    }
+
+    return file;
+}
+
+static bool read_entry(FILE* file, Entry* e) {
+    return fscanf(file, "%u %llx", &e->tick, &e->hash) == 2;
+}
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: hashdiff <a.hashes> <b.hashes>\n");
+        return 2;
+    }
+
+    FILE* fa = open_log(argv[1]);
+    FILE* fb = open_log(argv[2]);
+    Entry a, b;
+    uint32_t n = 0;
+
+    for (;;) {
+        bool ok_a = read_entry(fa, &a);
+        bool ok_b = read_entry(fb, &b);
+
+        if (!ok_a && !ok_b) {
+            printf("identical over %u ticks\n", n);
+            return 0;
+        }
+
+        if (!ok_a || !ok_b) {
+            printf("%s ends after %u ticks\n", ok_a ? argv[2] : argv[1], n);
+            return 1;
+        }
+
+        if (a.tick != b.tick || a.hash != b.hash) {
+            printf("first divergence at tick %u: %016llx != %016llx\n", a.tick, a.hash, b.hash);
+
+            if (a.tick != b.tick) {
+                printf("tick numbers differ: %u != %u\n", a.tick, b.tick);
+            }
+
+            return 1;
+        }
+
+        n++;
+    }
+}
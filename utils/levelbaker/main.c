@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "bitboard.h"
+
+static void write_bytes(FILE* file, const char* name, const uint8_t* b, size_t len);
+static void write_sprites(FILE* file, GameState* gs);
+static void write_level(FILE* file, GameState* gs);
+
+static void write_bytes(FILE* file, const char* name, const uint8_t* b, size_t len) {
+    fprintf(file, "        .%s = {", name);
+
+    for (size_t i = 0; i < len; i++) {
+        if (i % 16 == 0) {
+            fprintf(file, "\n           ");
+        }
+
+        fprintf(file, " %3u,", b[i]);
+    }
+
+    fprintf(file, "\n        },\n");
+}
+
+static void write_sprites(FILE* file, GameState* gs) {
+    fprintf(file, "        .sprites = {\n");
+
+    for (uint32_t i = 0; i < gs->n_sprites; i++) {
+        Sprite* s = &gs->sprites[i];
+        fprintf(file, "            { { %d, %d }, { %d, %d }, %u, %u },\n",
+                s->p.x, s->p.y, s->d.x, s->d.y, s->flags, s->tile);
+    }
+
+    fprintf(file, "        },\n");
+}
+
+static void write_level(FILE* file, GameState* gs) {
+    Board bb;
+    Deadlocks dl;
+    uint8_t regions[MAP_W * MAP_H];
+    gs_decode_level(gs);
+    bb_load(&bb, gs);
+    bb_deadlocks(&dl, &bb);
+    assert(!bb_deadlocked(&dl, &bb));
+    bb_pack_deadlocks(&dl, regions);
+    fprintf(file, "    {\n");
+    fprintf(file, "        .to_clear = %d,\n", gs->to_clear);
+    fprintf(file, "        .n_sprites = %u,\n", gs->n_sprites);
+    fprintf(file, "        .wraps = %s,\n", gs->wraps ? "true" : "false");
+    write_bytes(file, "walls", gs->walls, sizeof(gs->walls));
+    write_bytes(file, "grid", gs->grid, sizeof(gs->grid));
+    write_bytes(file, "regions", regions, sizeof(regions));
+    write_bytes(file, "grid_next", gs->grid_next, gs->n_sprites);
+    write_sprites(file, gs);
+    fprintf(file, "    },\n");
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <level_state.h>\n", argv[0]);
+        return 2;
+    }
+
+    GameState* gs = gs_init(0.0);
+
+    if (gs == NULL) {
+        fprintf(stderr, "alloc failure\n");
+        return 1;
+    }
+
+    FILE* file = fopen(argv[1], "w");
+
+    if (file == NULL) {
+        fprintf(stderr, "cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    fprintf(file, "#pragma once\n#include \"gamestate.h\"\n\n");
+    fprintf(file, "static const LevelState LEVEL_STATE[MAX_LEVEL] = {\n");
+
+    for (int32_t i = 0; i < MAX_LEVEL; i++) {
+        gs->level = i;
+        write_level(file, gs);
+    }
+
+    fprintf(file, "};\n");
+    gs_quit(gs);
+
+    if (fclose(file) != 0) {
+        fprintf(stderr, "cannot write %s\n", argv[1]);
+        return 1;
+    }
+}
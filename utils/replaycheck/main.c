@@ -0,0 +1,225 @@
+#define _DEFAULT_SOURCE
+#include <assert.h>
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include "scene.h"
+
+typedef struct {
+    bool loaded;
+    bool resumed;
+    bool valid;
+    int32_t score;
+    int32_t claimed;
+    int32_t level;
+    uint32_t ticks;
+    int64_t diverged;
+} Verdict;
+
+static char** list_replays(const char* dir, uint32_t* n);
+static int cmp_names(const void* a, const void* b);
+static double run_to(Backend* be, GameState* gs, double time, uint32_t tick);
+static void verify(const char* path, Verdict* v);
+static void run_worker(char** paths, uint32_t n, uint32_t* next, Verdict* out);
+static double now_secs(void);
+
+static char** list_replays(const char* dir, uint32_t* n) {
+    DIR* d = opendir(dir);
+
+    if (d == NULL) {
+        fprintf(stderr, "cannot open %s\n", dir);
+        exit(2);
+    }
+
+    char** paths = NULL;
+    uint32_t cap = 0;
+    struct dirent* e;
+    *n = 0;
+
+    while ((e = readdir(d)) != NULL) {
+        char* path = malloc(strlen(dir) + strlen(e->d_name) + 2);
+        struct stat st;
+        assert(path != NULL);
+        sprintf(path, "%s/%s", dir, e->d_name);
+
+        if (stat(path, &st) != 0 || !S_ISREG(st.st_mode)) {
+            free(path);
+            continue;
+        }
+
+        if (*n == cap) {
+            cap = cap ? cap * 2 : 256;
+            paths = realloc(paths, cap * sizeof(char*));
+            assert(paths != NULL);
+        }
+
+        paths[(*n)++] = path;
+    }
+
+    closedir(d);
+    qsort(paths, *n, sizeof(char*), cmp_names);
+    return paths;
+}
+
+static int cmp_names(const void* a, const void* b) {
+    return strcmp(*(char* const*) a, *(char* const*) b);
+}
+
+static double run_to(Backend* be, GameState* gs, double time, uint32_t tick) {
+    while (gs->tick < tick && gs_update(gs, be, time)) {
+        time += TICK_MS;
+    }
+
+    return time;
+}
+
+static void verify(const char* path, Verdict* v) {
+    Backend* be = be_open_replay(path);
+    GameState* gs = gs_init(0.0);
+    *v = (Verdict) { .diverged = -1 };
+
+    if (be == NULL || gs == NULL) {
+        if (gs != NULL) {
+            gs_quit(gs);
+        }
+
+        return;
+    }
+
+    v->loaded = true;
+    v->resumed = be->hdr.start_len != 0;
+
+    if (v->resumed) {
+        gs_quit(gs);
+        be_quit(be);
+        return;
+    }
+
+    gs->fixed = true;
+    sc_init(be);
+    gs_set_scene(gs, SC_SPLASH, 5);
+
+    double time = 0.0;
+
+    for (uint32_t i = 0; i < be->hdr.n_keyframes && v->diverged < 0; i++) {
+        const Keyframe* kf = (const Keyframe*) &be->kf_data[be->kf_index[i].offset];
+        SaveState ss;
+        time = run_to(be, gs, time, kf->state.tick);
+        ss_store(gs, &ss);
+        ss.acc = kf->state.acc;
+        v->claimed = kf->state.score;
+
+        if (memcmp(&ss, &kf->state, sizeof(SaveState)) != 0) {
+            v->diverged = kf->state.tick;
+        }
+    }
+
+    if (v->diverged < 0) {
+        run_to(be, gs, time, be->hdr.end_tick);
+        v->valid = gs->tick == be->hdr.end_tick && gs_hash(gs) == be->hdr.end_hash;
+
+        if (!v->valid) {
+            v->diverged = gs->tick;
+        }
+    }
+
+    v->score = gs->score;
+    v->level = gs->level;
+    v->ticks = gs->tick;
+    sc_quit(be);
+    gs_quit(gs);
+    be_quit(be);
+}
+
+static void run_worker(char** paths, uint32_t n, uint32_t* next, Verdict* out) {
+    for (;;) {
+        uint32_t i = __atomic_fetch_add(next, 1, __ATOMIC_RELAXED);
+
+        if (i >= n) {
+            break;
+        }
+
+        verify(paths[i], &out[i]);
+    }
+}
+
+static double now_secs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        fprintf(stderr, "usage: replaycheck <replay dir> [workers]\n");
+        return 2;
+    }
+
+    uint32_t n = 0;
+    char** paths = list_replays(argv[1], &n);
+    long cores = argc == 3 ? atol(argv[2]) : sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t n_workers = cores < 1 ? 1 : (uint32_t) cores;
+
+    if (n_workers > n) {
+        n_workers = n > 0 ? n : 1;
+    }
+
+    size_t size = sizeof(uint32_t) * 2 + n * sizeof(Verdict);
+    void* shared = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    assert(shared != MAP_FAILED);
+    uint32_t* next = shared;
+    Verdict* verdicts = (Verdict*) (next + 2);
+    double t0 = now_secs();
+
+    for (uint32_t w = 0; w < n_workers; w++) {
+        pid_t pid = fork();
+        assert(pid >= 0);
+
+        if (pid == 0) {
+            run_worker(paths, n, next, verdicts);
+            _exit(0);
+        }
+    }
+
+    while (wait(NULL) > 0) {
+    }
+
+    double secs = now_secs() - t0;
+    uint32_t n_valid = 0;
+    uint64_t ticks = 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        Verdict* v = &verdicts[i];
+        ticks += v->ticks;
+
+        if (!v->loaded) {
+            printf("%s: unreadable\n", paths[i]);
+        } else if (v->resumed) {
+            printf("%s: rejected, starts from a saved state\n", paths[i]);
+        } else if (v->valid) {
+            n_valid++;
+            printf("%s: valid score %d level %d ticks %u\n", paths[i], v->score, v->level, v->ticks);
+        } else {
+            printf("%s: invalid score %d claimed %d level %d diverged %lld\n",
+                   paths[i], v->score, v->claimed, v->level, (long long) v->diverged);
+        }
+    }
+
+    fprintf(stderr, "%u/%u valid, %u workers, %.3f s, %.1f replays/s/core, %.1f Mticks/s\n",
+            n_valid, n, n_workers, secs, secs > 0 ? n / secs / n_workers : 0.0,
+            secs > 0 ? (double) ticks / secs / 1e6 : 0.0);
+
+    for (uint32_t i = 0; i < n; i++) {
+        free(paths[i]);
+    }
+
+    free(paths);
+    munmap(shared, size);
+    return n_valid == n ? 0 : 1;
+}
@@ -0,0 +1,311 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "codec.h"
+#include "replay.h"
+
+#define LZ_HASH_BITS 14
+#define LZ_MIN_MATCH 4
+#define LZ_WINDOW 65535
+
+static uint32_t lz_hash(const uint8_t* p);
+static void put_literals(ByteBuf* out, const uint8_t* src, size_t len);
+static bool get_u32(const uint8_t** p, const uint8_t* end, uint32_t* v);
+static bool in_bounds(const KeyframeRef* index, uint32_t len, uint32_t size);
+static void xor_states(uint8_t* data, const KeyframeRef* index, uint32_t len);
+
+void buf_put(ByteBuf* b, const void* src, size_t len) {
+    if (b->cap - b->len < len) {
+        size_t cap = b->cap ? b->cap : 4096;
+
+        while (cap - b->len < len) {
+            cap *= 2;
+        }
+
+        b->ptr = realloc(b->ptr, cap);
+        assert(b->ptr != NULL);
+        b->cap = cap;
+    }
+
+    memcpy(&b->ptr[b->len], src, len);
+    b->len += len;
+}
+
+void buf_put_varint(ByteBuf* b, uint64_t v) {
+    uint8_t bytes[10];
+    size_t n = 0;
+
+    while (v >= 0x80) {
+        bytes[n++] = (uint8_t) (v | 0x80);
+        v >>= 7;
+    }
+
+    bytes[n++] = (uint8_t) v;
+    buf_put(b, bytes, n);
+}
+
+void buf_free(ByteBuf* b) {
+    free(b->ptr);
+    *b = (ByteBuf) { 0 };
+}
+
+bool get_varint(const uint8_t** p, const uint8_t* end, uint64_t* v) {
+    *v = 0;
+
+    for (int shift = 0; shift < 64 && *p < end; shift += 7) {
+        uint8_t byte = *(*p)++;
+        *v |= (uint64_t) (byte & 0x7f) << shift;
+
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void lz_compress(const uint8_t* src, size_t len, ByteBuf* out) {
+    static size_t table[1 << LZ_HASH_BITS];
+    memset(table, 0xff, sizeof(table));
+    size_t lit = 0;
+    size_t i = 0;
+
+    while (i + LZ_MIN_MATCH <= len) {
+        uint32_t h = lz_hash(&src[i]);
+        size_t cand = table[h];
+        table[h] = i;
+
+        if (cand == SIZE_MAX || i - cand > LZ_WINDOW || memcmp(&src[cand], &src[i], LZ_MIN_MATCH) != 0) {
+            i++;
+            continue;
+        }
+
+        size_t n = LZ_MIN_MATCH;
+
+        while (i + n < len && src[cand + n] == src[i + n]) {
+            n++;
+        }
+
+        put_literals(out, &src[lit], i - lit);
+        buf_put_varint(out, (uint64_t) (n - LZ_MIN_MATCH) << 1 | 1);
+        buf_put_varint(out, i - cand);
+        i += n;
+        lit = i;
+    }
+
+    put_literals(out, &src[lit], len - lit);
+}
+
+bool lz_decompress(const uint8_t* src, size_t len, uint8_t* dst, size_t dst_len) {
+    const uint8_t* end = src + len;
+    size_t pos = 0;
+
+    while (src < end) {
+        uint64_t token;
+        uint64_t dist;
+
+        if (!get_varint(&src, end, &token)) {
+            return false;
+        }
+
+        uint64_t n = token >> 1;
+
+        if (!(token & 1)) {
+            if (n > (uint64_t) (end - src) || n > dst_len - pos) {
+                return false;
+            }
+
+            memcpy(&dst[pos], src, n);
+            src += n;
+            pos += n;
+            continue;
+        }
+
+        n += LZ_MIN_MATCH;
+
+        if (!get_varint(&src, end, &dist) || dist == 0 || dist > pos || n > dst_len - pos) {
+            return false;
+        }
+
+        for (uint64_t k = 0; k < n; k++, pos++) {
+            dst[pos] = dst[pos - dist];
+        }
+    }
+
+    return pos == dst_len;
+}
+
+bool ar_encode_replay(const uint8_t* file, size_t len, ByteBuf* out, ReplayMeta* meta) {
+    ReplayHeader hdr;
+
+    if (len < sizeof(ReplayHeader)) {
+        return false;
+    }
+
+    memcpy(&hdr, file, sizeof(ReplayHeader));
+    uint64_t inputs_size = (uint64_t) hdr.n_inputs * sizeof(ReplayInput);
+    uint64_t index_size = (uint64_t) hdr.n_keyframes * sizeof(KeyframeRef);
+
+    if (hdr.magic != RP_MAGIC || hdr.version != RP_VERSION ||
+            len != sizeof(ReplayHeader) + inputs_size + index_size + hdr.kf_size) {
+        return false;
+    }
+
+    const ReplayInput* inputs = (const ReplayInput*) &file[sizeof(ReplayHeader)];
+    const KeyframeRef* index = (const KeyframeRef*) &file[sizeof(ReplayHeader) + inputs_size];
+    const uint8_t* kf_data = &file[sizeof(ReplayHeader) + inputs_size + index_size];
+
+    if (!rp_check_keyframes(index, hdr.n_keyframes, kf_data, hdr.kf_size)) {
+        return false;
+    }
+
+    buf_put_varint(out, hdr.fixed);
+    buf_put_varint(out, hdr.n_inputs);
+    buf_put_varint(out, hdr.n_keyframes);
+    buf_put_varint(out, hdr.kf_size);
+    buf_put_varint(out, hdr.start_len);
+    buf_put_varint(out, hdr.end_tick);
+    buf_put_varint(out, hdr.build);
+    buf_put_varint(out, hdr.end_hash);
+    buf_put(out, &hdr.start, sizeof(SaveState));
+
+    for (uint32_t i = 0, tick = 0; i < hdr.n_inputs; i++) {
+        buf_put_varint(out, inputs[i].tick - tick);
+        buf_put_varint(out, inputs[i].event);
+        tick = inputs[i].tick;
+    }
+
+    for (uint32_t i = 0, tick = 0, offset = 0; i < hdr.n_keyframes; i++) {
+        buf_put_varint(out, index[i].tick - tick);
+        buf_put_varint(out, index[i].offset - offset);
+        tick = index[i].tick;
+        offset = index[i].offset;
+    }
+
+    size_t data_pos = out->len;
+    buf_put(out, kf_data, hdr.kf_size);
+
+    for (uint32_t i = 1; i < hdr.n_keyframes; i++) {
+        uint8_t* cur = &out->ptr[data_pos + index[i].offset];
+        const uint8_t* prev = &kf_data[index[i - 1].offset];
+
+        for (size_t k = 0; k < sizeof(SaveState); k++) {
+            cur[k] ^= prev[k];
+        }
+    }
+
+    const Keyframe* last = hdr.n_keyframes > 0 ?
+        (const Keyframe*) &kf_data[index[hdr.n_keyframes - 1].offset] : NULL;
+    *meta = (ReplayMeta) {
+        .end_tick = hdr.end_tick,
+        .build = hdr.build,
+        .level = last != NULL ? last->state.level : 0,
+        .score = last != NULL ? last->state.score : 0,
+    };
+    return true;
+}
+
+bool ar_decode_replay(const uint8_t* src, size_t len, ByteBuf* out) {
+    const uint8_t* end = src + len;
+    ReplayHeader hdr = { .magic = RP_MAGIC, .version = RP_VERSION };
+    uint32_t fixed;
+
+    if (!get_u32(&src, end, &fixed) || !get_u32(&src, end, &hdr.n_inputs) ||
+            !get_u32(&src, end, &hdr.n_keyframes) || !get_u32(&src, end, &hdr.kf_size) ||
+            !get_u32(&src, end, &hdr.start_len) || !get_u32(&src, end, &hdr.end_tick) ||
+            !get_u32(&src, end, &hdr.build) || !get_varint(&src, end, &hdr.end_hash) ||
+            (size_t) (end - src) < sizeof(SaveState)) {
+        return false;
+    }
+
+    hdr.fixed = (uint16_t) fixed;
+    memcpy(&hdr.start, src, sizeof(SaveState));
+    src += sizeof(SaveState);
+    buf_put(out, &hdr, sizeof(ReplayHeader));
+
+    for (uint32_t i = 0, tick = 0; i < hdr.n_inputs; i++) {
+        uint32_t gap;
+        ReplayInput input;
+
+        if (!get_u32(&src, end, &gap) || !get_u32(&src, end, &input.event)) {
+            return false;
+        }
+
+        tick += gap;
+        input.tick = tick;
+        buf_put(out, &input, sizeof(ReplayInput));
+    }
+
+    size_t index_pos = out->len;
+
+    for (uint32_t i = 0, tick = 0, offset = 0; i < hdr.n_keyframes; i++) {
+        uint32_t gap;
+        uint32_t step;
+
+        if (!get_u32(&src, end, &gap) || !get_u32(&src, end, &step)) {
+            return false;
+        }
+
+        tick += gap;
+        offset += step;
+        buf_put(out, &(KeyframeRef) { tick, offset }, sizeof(KeyframeRef));
+    }
+
+    size_t data_pos = out->len;
+    const KeyframeRef* index = (const KeyframeRef*) &out->ptr[index_pos];
+
+    if ((size_t) (end - src) != hdr.kf_size || !in_bounds(index, hdr.n_keyframes, hdr.kf_size)) {
+        return false;
+    }
+
+    buf_put(out, src, hdr.kf_size);
+    index = (const KeyframeRef*) &out->ptr[index_pos];
+    xor_states(&out->ptr[data_pos], index, hdr.n_keyframes);
+    return rp_check_keyframes(index, hdr.n_keyframes, &out->ptr[data_pos], hdr.kf_size);
+}
+
+static uint32_t lz_hash(const uint8_t* p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return (v * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+static void put_literals(ByteBuf* out, const uint8_t* src, size_t len) {
+    if (len > 0) {
+        buf_put_varint(out, (uint64_t) len << 1);
+        buf_put(out, src, len);
+    }
+}
+
+static bool get_u32(const uint8_t** p, const uint8_t* end, uint32_t* v) {
+    uint64_t wide;
+
+    if (!get_varint(p, end, &wide) || wide > UINT32_MAX) {
+        return false;
+    }
+
+    *v = (uint32_t) wide;
+    return true;
+}
+
+static bool in_bounds(const KeyframeRef* index, uint32_t len, uint32_t size) {
+    for (uint32_t i = 0; i < len; i++) {
+        if (index[i].offset % _Alignof(Keyframe) != 0 || index[i].offset > size ||
+                size - index[i].offset < sizeof(Keyframe)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void xor_states(uint8_t* data, const KeyframeRef* index, uint32_t len) {
+    for (uint32_t i = 1; i < len; i++) {
+        uint8_t* cur = &data[index[i].offset];
+        const uint8_t* prev = &data[index[i - 1].offset];
+
+        for (size_t k = 0; k < sizeof(SaveState); k++) {
+            cur[k] ^= prev[k];
+        }
+    }
+}
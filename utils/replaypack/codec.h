@@ -0,0 +1,27 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+    uint8_t* ptr;
+    size_t len;
+    size_t cap;
+} ByteBuf;
+
+typedef struct {
+    uint32_t end_tick;
+    uint32_t build;
+    int32_t level;
+    int32_t score;
+} ReplayMeta;
+
+void buf_put(ByteBuf* b, const void* src, size_t len);
+void buf_put_varint(ByteBuf* b, uint64_t v);
+void buf_free(ByteBuf* b);
+bool get_varint(const uint8_t** p, const uint8_t* end, uint64_t* v);
+void lz_compress(const uint8_t* src, size_t len, ByteBuf* out);
+bool lz_decompress(const uint8_t* src, size_t len, uint8_t* dst, size_t dst_len);
+bool ar_encode_replay(const uint8_t* file, size_t len, ByteBuf* out, ReplayMeta* meta);
+bool ar_decode_replay(const uint8_t* src, size_t len, ByteBuf* out);
@@ -0,0 +1,338 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "codec.h"
+
+#define AR_MAGIC 0x41524d41u
+#define AR_INDEX_MAGIC 0x49524d41u
+#define AR_VERSION 1
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+} ArchiveHeader;
+
+typedef struct {
+    uint64_t index_offset;
+    uint32_t count;
+    uint32_t index_len;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t magic;
+} ArchiveTrailer;
+
+typedef struct {
+    uint32_t count;
+    uint32_t cap;
+    uint64_t* offset;
+    uint32_t* comp_len;
+    uint32_t* raw_len;
+    uint32_t* end_tick;
+    uint32_t* build;
+    int32_t* level;
+    int32_t* score;
+    uint32_t* name_end;
+    ByteBuf names;
+} ArchiveIndex;
+
+static void die(const char* msg, const char* arg);
+static uint8_t* read_file(const char* path, size_t* len);
+static void grow_index(ArchiveIndex* ix);
+static void free_index(ArchiveIndex* ix);
+static bool read_index(FILE* file, ArchiveIndex* ix);
+static void write_index(FILE* file, ArchiveIndex* ix);
+static const char* entry_name(ArchiveIndex* ix, uint32_t i, size_t* len);
+static int pack(const char* archive, int n, char** paths);
+static int list(const char* archive);
+static int extract(const char* archive, const char* key, const char* out_path);
+
+static void die(const char* msg, const char* arg) {
+    fprintf(stderr, "%s %s\n", msg, arg);
+    exit(2);
+}
+
+static uint8_t* read_file(const char* path, size_t* len) {
+    FILE* file = fopen(path, "rb");
+
+    if (file == NULL) {
+        return NULL;
+    }
+
+    ByteBuf b = { 0 };
+    uint8_t chunk[1 << 16];
+    size_t n;
+
+    while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        buf_put(&b, chunk, n);
+    }
+
+    fclose(file);
+    *len = b.len;
+    return b.ptr;
+}
+
+static void grow_index(ArchiveIndex* ix) {
+    if (ix->count < ix->cap) {
+        return;
+    }
+
+    ix->cap = ix->cap ? ix->cap * 2 : 256;
+    ix->offset = realloc(ix->offset, ix->cap * sizeof(uint64_t));
+    ix->comp_len = realloc(ix->comp_len, ix->cap * sizeof(uint32_t));
+    ix->raw_len = realloc(ix->raw_len, ix->cap * sizeof(uint32_t));
+    ix->end_tick = realloc(ix->end_tick, ix->cap * sizeof(uint32_t));
+    ix->build = realloc(ix->build, ix->cap * sizeof(uint32_t));
+    ix->level = realloc(ix->level, ix->cap * sizeof(int32_t));
+    ix->score = realloc(ix->score, ix->cap * sizeof(int32_t));
+    ix->name_end = realloc(ix->name_end, ix->cap * sizeof(uint32_t));
+    assert(ix->offset != NULL && ix->comp_len != NULL && ix->raw_len != NULL &&
+           ix->end_tick != NULL && ix->build != NULL && ix->level != NULL &&
+           ix->score != NULL && ix->name_end != NULL);
+}
+
+static void free_index(ArchiveIndex* ix) {
+    free(ix->offset);
+    free(ix->comp_len);
+    free(ix->raw_len);
+    free(ix->end_tick);
+    free(ix->build);
+    free(ix->level);
+    free(ix->score);
+    free(ix->name_end);
+    buf_free(&ix->names);
+}
+
+static bool read_index(FILE* file, ArchiveIndex* ix) {
+    ArchiveTrailer tr;
+
+    if (fseek(file, -(long) sizeof(ArchiveTrailer), SEEK_END) != 0 ||
+            fread(&tr, sizeof(ArchiveTrailer), 1, file) != 1 ||
+            tr.magic != AR_INDEX_MAGIC || tr.version != AR_VERSION ||
+            fseek(file, (long) tr.index_offset, SEEK_SET) != 0) {
+        return false;
+    }
+
+    while (ix->cap < tr.count) {
+        grow_index(ix);
+    }
+
+    size_t n = tr.count;
+    bool ok = fread(ix->offset, sizeof(uint64_t), n, file) == n &&
+        fread(ix->comp_len, sizeof(uint32_t), n, file) == n &&
+        fread(ix->raw_len, sizeof(uint32_t), n, file) == n &&
+        fread(ix->end_tick, sizeof(uint32_t), n, file) == n &&
+        fread(ix->build, sizeof(uint32_t), n, file) == n &&
+        fread(ix->level, sizeof(int32_t), n, file) == n &&
+        fread(ix->score, sizeof(int32_t), n, file) == n &&
+        fread(ix->name_end, sizeof(uint32_t), n, file) == n;
+    uint32_t names_len = n > 0 ? ix->name_end[n - 1] : 0;
+
+    if (!ok || names_len != tr.index_len - n * (sizeof(uint64_t) + 7 * sizeof(uint32_t))) {
+        return false;
+    }
+
+    ix->names.len = 0;
+    uint8_t* names = malloc(names_len + 1);
+    assert(names != NULL);
+    ok = fread(names, 1, names_len, file) == names_len;
+    buf_put(&ix->names, names, names_len);
+    free(names);
+    ix->count = tr.count;
+    return ok;
+}
+
+static void write_index(FILE* file, ArchiveIndex* ix) {
+    size_t n = ix->count;
+    ArchiveTrailer tr = {
+        .index_offset = (uint64_t) ftell(file),
+        .count = ix->count,
+        .index_len = (uint32_t) (n * (sizeof(uint64_t) + 7 * sizeof(uint32_t)) + ix->names.len),
+        .version = AR_VERSION,
+        .magic = AR_INDEX_MAGIC,
+    };
+    fwrite(ix->offset, sizeof(uint64_t), n, file);
+    fwrite(ix->comp_len, sizeof(uint32_t), n, file);
+    fwrite(ix->raw_len, sizeof(uint32_t), n, file);
+    fwrite(ix->end_tick, sizeof(uint32_t), n, file);
+    fwrite(ix->build, sizeof(uint32_t), n, file);
+    fwrite(ix->level, sizeof(int32_t), n, file);
+    fwrite(ix->score, sizeof(int32_t), n, file);
+    fwrite(ix->name_end, sizeof(uint32_t), n, file);
+    fwrite(ix->names.ptr, 1, ix->names.len, file);
+    fwrite(&tr, sizeof(ArchiveTrailer), 1, file);
+}
+
+static const char* entry_name(ArchiveIndex* ix, uint32_t i, size_t* len) {
+    uint32_t start = i > 0 ? ix->name_end[i - 1] : 0;
+    *len = ix->name_end[i] - start;
+    return (const char*) &ix->names.ptr[start];
+}
+
+static int pack(const char* archive, int n, char** paths) {
+    ArchiveIndex ix = { 0 };
+    FILE* file = fopen(archive, "r+b");
+
+    if (file != NULL) {
+        if (!read_index(file, &ix)) {
+            die("not a replay archive:", archive);
+        }
+    } else {
+        file = fopen(archive, "w+b");
+
+        if (file == NULL) {
+            die("cannot create", archive);
+        }
+
+        ArchiveHeader hdr = { AR_MAGIC, AR_VERSION, 0 };
+        fwrite(&hdr, sizeof(ArchiveHeader), 1, file);
+    }
+
+    fseek(file, 0, SEEK_END);
+    uint64_t bytes_in = 0;
+    uint64_t bytes_out = 0;
+    int packed = 0;
+
+    for (int i = 0; i < n; i++) {
+        size_t len;
+        uint8_t* data = read_file(paths[i], &len);
+        ByteBuf raw = { 0 };
+        ByteBuf comp = { 0 };
+        ReplayMeta meta;
+
+        if (data == NULL || !ar_encode_replay(data, len, &raw, &meta)) {
+            fprintf(stderr, "skipping %s: not a replay file\n", paths[i]);
+            free(data);
+            buf_free(&raw);
+            continue;
+        }
+
+        lz_compress(raw.ptr, raw.len, &comp);
+        grow_index(&ix);
+        const char* slash = strrchr(paths[i], '/');
+        const char* name = slash != NULL ? slash + 1 : paths[i];
+        uint32_t k = ix.count++;
+        ix.offset[k] = (uint64_t) ftell(file);
+        ix.comp_len[k] = (uint32_t) comp.len;
+        ix.raw_len[k] = (uint32_t) raw.len;
+        ix.end_tick[k] = meta.end_tick;
+        ix.build[k] = meta.build;
+        ix.level[k] = meta.level;
+        ix.score[k] = meta.score;
+        buf_put(&ix.names, name, strlen(name));
+        ix.name_end[k] = (uint32_t) ix.names.len;
+        fwrite(comp.ptr, 1, comp.len, file);
+        bytes_in += len;
+        bytes_out += comp.len;
+        packed++;
+        free(data);
+        buf_free(&raw);
+        buf_free(&comp);
+    }
+
+    write_index(file, &ix);
+    int err = fclose(file);
+    fprintf(stderr, "packed %d replays, %llu -> %llu bytes, %u in archive\n", packed,
+            (unsigned long long) bytes_in, (unsigned long long) bytes_out, ix.count);
+    free_index(&ix);
+    return err ? 1 : 0;
+}
+
+static int list(const char* archive) {
+    ArchiveIndex ix = { 0 };
+    FILE* file = fopen(archive, "rb");
+
+    if (file == NULL || !read_index(file, &ix)) {
+        die("not a replay archive:", archive);
+    }
+
+    for (uint32_t i = 0; i < ix.count; i++) {
+        size_t len;
+        const char* name = entry_name(&ix, i, &len);
+        printf("%6u %-24.*s level %d score %7d ticks %8u build %08x %7u bytes\n", i,
+               (int) len, name, ix.level[i], ix.score[i], ix.end_tick[i], ix.build[i],
+               ix.comp_len[i]);
+    }
+
+    fclose(file);
+    free_index(&ix);
+    return 0;
+}
+
+static int extract(const char* archive, const char* key, const char* out_path) {
+    ArchiveIndex ix = { 0 };
+    FILE* file = fopen(archive, "rb");
+
+    if (file == NULL || !read_index(file, &ix)) {
+        die("not a replay archive:", archive);
+    }
+
+    char* end;
+    unsigned long k = strtoul(key, &end, 10);
+
+    if (*end != '\0' || k >= ix.count) {
+        for (k = 0; k < ix.count; k++) {
+            size_t len;
+            const char* name = entry_name(&ix, (uint32_t) k, &len);
+
+            if (len == strlen(key) && memcmp(name, key, len) == 0) {
+                break;
+            }
+        }
+    }
+
+    if (k >= ix.count) {
+        die("no such replay:", key);
+    }
+
+    uint8_t* comp = malloc(ix.comp_len[k] + 1);
+    uint8_t* raw = malloc(ix.raw_len[k] + 1);
+    ByteBuf out = { 0 };
+    assert(comp != NULL && raw != NULL);
+
+    if (fseek(file, (long) ix.offset[k], SEEK_SET) != 0 ||
+            fread(comp, 1, ix.comp_len[k], file) != ix.comp_len[k] ||
+            !lz_decompress(comp, ix.comp_len[k], raw, ix.raw_len[k]) ||
+            !ar_decode_replay(raw, ix.raw_len[k], &out)) {
+        die("corrupt replay:", key);
+    }
+
+    size_t len;
+    const char* name = entry_name(&ix, (uint32_t) k, &len);
+    char path[1024];
+    snprintf(path, sizeof(path), "%.*s", (int) len, name);
+    FILE* dst = fopen(out_path != NULL ? out_path : path, "wb");
+
+    if (dst == NULL) {
+        die("cannot create", out_path != NULL ? out_path : path);
+    }
+
+    bool ok = fwrite(out.ptr, 1, out.len, dst) == out.len;
+    ok = !fclose(dst) && ok;
+    fclose(file);
+    free(comp);
+    free(raw);
+    buf_free(&out);
+    free_index(&ix);
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 4 && strcmp(argv[1], "pack") == 0) {
+        return pack(argv[2], argc - 3, &argv[3]);
+    }
+
+    if (argc == 3 && strcmp(argv[1], "list") == 0) {
+        return list(argv[2]);
+    }
+
+    if ((argc == 4 || argc == 5) && strcmp(argv[1], "extract") == 0) {
+        return extract(argv[2], argv[3], argc == 5 ? argv[4] : NULL);
+    }
+
+    fprintf(stderr, "usage: replaypack pack <archive> <replay>...\n"
+                    "       replaypack list <archive>\n"
+                    "       replaypack extract <archive> <index|name> [out]\n");
+    return 2;
+}
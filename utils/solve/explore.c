@@ -0,0 +1,318 @@
+#define _DEFAULT_SOURCE
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "explore.h"
+
+#define MAX_RUNS 64
+
+typedef struct {
+    FILE* file;
+    Record rec;
+    bool live;
+    bool visited;
+} Source;
+
+typedef struct {
+    const char* dir;
+    uint32_t n_files;
+    Record* buf;
+    size_t n_buf;
+    size_t cap_buf;
+    FILE* runs[MAX_RUNS];
+    uint32_t n_runs;
+    uint32_t total_runs;
+    bool failed;
+} Explorer;
+
+_Static_assert(sizeof(Record) == 104, "Record layout");
+
+static int compare(const void* a, const void* b);
+static FILE* open_temp(Explorer* ex);
+static bool read_record(FILE* file, Record* r);
+static void write_record(Explorer* ex, FILE* file, Record* r);
+static void spill(Explorer* ex);
+static void add_child(Explorer* ex, Board* bb);
+static void advance(Source* src);
+static void merge(Explorer* ex, FILE* visited, FILE* next_visited, FILE* frontier, uint64_t* n_new);
+
+bool ex_apply(Board* bb, uint8_t action, GameEvent* ev) {
+    if (action != ACT_SWAP) {
+        return bb_move(bb, BB_DIRS[action], ev);
+    }
+
+    Mask anti = bb->pcs[BB_ANTI];
+    bb->pcs[BB_ANTI] = bb->pcs[BB_MATTER];
+    bb->pcs[BB_MATTER] = anti;
+    bb->energy -= SWAP_COST;
+    *ev = bb->energy < 1 ? GE_EXHAUSTED : GE_MOVE;
+    return true;
+}
+
+void ex_pack(Record* r, const Board* bb) {
+    memcpy(r->pcs, &bb->pcs[BB_BLOB_B], sizeof(r->pcs));
+    r->energy = bb->energy;
+    r->to_clear = bb->to_clear;
+}
+
+void ex_unpack(Board* bb, const Record* r, const Board* start) {
+    bb->pcs[BB_WALL] = start->pcs[BB_WALL];
+    memcpy(&bb->pcs[BB_BLOB_B], r->pcs, sizeof(r->pcs));
+    bb->energy = r->energy;
+    bb->to_clear = r->to_clear;
+}
+
+bool ex_run(Board* start, const char* name, size_t mem_limit, const char* dir) {
+    Explorer ex = { .dir = dir, .cap_buf = mem_limit / sizeof(Record) };
+
+    if (ex.cap_buf == 0) {
+        return false;
+    }
+
+    ex.buf = malloc(ex.cap_buf * sizeof(Record));
+    assert(ex.buf != NULL);
+    FILE* visited = open_temp(&ex);
+    FILE* frontier = open_temp(&ex);
+
+    if (visited == NULL || frontier == NULL) {
+        free(ex.buf);
+        return false;
+    }
+
+    Record root;
+    ex_pack(&root, start);
+    write_record(&ex, visited, &root);
+    write_record(&ex, frontier, &root);
+    uint64_t n_layer = 1;
+    uint64_t total = 0;
+    uint64_t total_dead = 0;
+    uint64_t total_cleared = 0;
+    uint32_t depth = 0;
+
+    for (; n_layer > 0; depth++) {
+        uint64_t dead = 0;
+        uint64_t cleared = 0;
+        Record r;
+        rewind(frontier);
+
+        while (read_record(frontier, &r)) {
+            Board bb;
+            ex_unpack(&bb, &r, start);
+
+            if (bb.to_clear <= 0) {
+                cleared++;
+                continue;
+            }
+
+            bool moved = false;
+
+            for (uint8_t a = 0; a < ACTIONS; a++) {
+                Board next = bb;
+                GameEvent ev;
+
+                if (!ex_apply(&next, a, &ev) || ev == GE_EXPLODE || ev == GE_EXHAUSTED) {
+                    continue;
+                }
+
+                moved = true;
+                add_child(&ex, &next);
+            }
+
+            dead += !moved;
+        }
+
+        printf("%s: depth %u: %llu states, %llu dead ends, %llu cleared\n", name, depth,
+               (unsigned long long) n_layer, (unsigned long long) dead, (unsigned long long) cleared);
+        total += n_layer;
+        total_dead += dead;
+        total_cleared += cleared;
+        spill(&ex);
+        FILE* next_visited = open_temp(&ex);
+        FILE* next_frontier = open_temp(&ex);
+
+        if (next_visited == NULL || next_frontier == NULL) {
+            ex.failed = true;
+        } else {
+            rewind(visited);
+            merge(&ex, visited, next_visited, next_frontier, &n_layer);
+        }
+
+        fclose(visited);
+        fclose(frontier);
+        visited = next_visited;
+        frontier = next_frontier;
+
+        if (ex.failed) {
+            break;
+        }
+    }
+
+    if (ex.failed) {
+        fprintf(stderr, "%s: cannot write temporary files in %s\n", name, ex.dir);
+
+        for (uint32_t i = 0; i < ex.n_runs; i++) {
+            fclose(ex.runs[i]);
+        }
+
+        if (visited != NULL) {
+            fclose(visited);
+        }
+
+        if (frontier != NULL) {
+            fclose(frontier);
+        }
+
+        free(ex.buf);
+        return false;
+    }
+
+    printf("%s: %llu reachable states, %llu dead ends, %llu cleared, max depth %u, %u runs\n", name,
+           (unsigned long long) total, (unsigned long long) total_dead,
+           (unsigned long long) total_cleared, depth - 1, ex.total_runs);
+    fclose(visited);
+    fclose(frontier);
+    free(ex.buf);
+    return true;
+}
+
+static int compare(const void* a, const void* b) {
+    return memcmp(a, b, sizeof(Record));
+}
+
+static FILE* open_temp(Explorer* ex) {
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/antimatter-solve-%ld-%u.tmp", ex->dir, (long) getpid(), ex->n_files++);
+    FILE* file = fopen(path, "w+b");
+
+    if (file != NULL) {
+        unlink(path);
+    } else {
+        fprintf(stderr, "cannot create %s\n", path);
+    }
+
+    return file;
+}
+
+static bool read_record(FILE* file, Record* r) {
+    return fread(r, sizeof(Record), 1, file) == 1;
+}
+
+static void write_record(Explorer* ex, FILE* file, Record* r) {
+    if (fwrite(r, sizeof(Record), 1, file) != 1) {
+        ex->failed = true;
+    }
+}
+
+static void spill(Explorer* ex) {
+    if (ex->n_buf == 0) {
+        return;
+    }
+
+    qsort(ex->buf, ex->n_buf, sizeof(Record), compare);
+    FILE* run = open_temp(ex);
+
+    if (run == NULL) {
+        ex->failed = true;
+        ex->n_buf = 0;
+        return;
+    }
+
+    for (size_t i = 0; i < ex->n_buf; i++) {
+        if (i == 0 || compare(&ex->buf[i - 1], &ex->buf[i]) != 0) {
+            write_record(ex, run, &ex->buf[i]);
+        }
+    }
+
+    if (ex->n_runs == MAX_RUNS) {
+        FILE* merged = open_temp(ex);
+
+        if (merged == NULL) {
+            ex->failed = true;
+            ex->n_buf = 0;
+            fclose(run);
+            return;
+        }
+
+        merge(ex, NULL, merged, NULL, NULL);
+        ex->runs[ex->n_runs++] = merged;
+    }
+
+    ex->runs[ex->n_runs++] = run;
+    ex->total_runs++;
+    ex->n_buf = 0;
+}
+
+static void add_child(Explorer* ex, Board* bb) {
+    if (ex->n_buf == ex->cap_buf) {
+        spill(ex);
+    }
+
+    ex_pack(&ex->buf[ex->n_buf++], bb);
+}
+
+static void advance(Source* src) {
+    src->live = read_record(src->file, &src->rec);
+}
+
+static void merge(Explorer* ex, FILE* visited, FILE* next_visited, FILE* frontier, uint64_t* n_new) {
+    Source srcs[MAX_RUNS + 1];
+    uint32_t n = 0;
+
+    if (visited != NULL) {
+        srcs[n++] = (Source) { .file = visited, .visited = true };
+    }
+
+    for (uint32_t i = 0; i < ex->n_runs; i++) {
+        srcs[n++] = (Source) { .file = ex->runs[i] };
+        rewind(ex->runs[i]);
+    }
+
+    for (uint32_t i = 0; i < n; i++) {
+        advance(&srcs[i]);
+    }
+
+    uint64_t fresh = 0;
+
+    for (;;) {
+        Source* min = NULL;
+
+        for (uint32_t i = 0; i < n; i++) {
+            if (srcs[i].live && (min == NULL || compare(&srcs[i].rec, &min->rec) < 0)) {
+                min = &srcs[i];
+            }
+        }
+
+        if (min == NULL) {
+            break;
+        }
+
+        Record r = min->rec;
+        bool seen = false;
+
+        for (uint32_t i = 0; i < n; i++) {
+            while (srcs[i].live && compare(&srcs[i].rec, &r) == 0) {
+                seen |= srcs[i].visited;
+                advance(&srcs[i]);
+            }
+        }
+
+        write_record(ex, next_visited, &r);
+
+        if (!seen && frontier != NULL) {
+            write_record(ex, frontier, &r);
+            fresh++;
+        }
+    }
+
+    for (uint32_t i = 0; i < ex->n_runs; i++) {
+        fclose(ex->runs[i]);
+    }
+
+    if (n_new != NULL) {
+        *n_new = fresh;
+    }
+
+    ex->n_runs = 0;
+}
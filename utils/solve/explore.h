@@ -0,0 +1,18 @@
+#pragma once
+
+#include <stddef.h>
+#include "bitboard.h"
+
+#define ACTIONS 5
+#define ACT_SWAP 4
+
+typedef struct {
+    Mask pcs[BB_CLASSES - 1];
+    int32_t energy;
+    int32_t to_clear;
+} Record;
+
+bool ex_apply(Board* bb, uint8_t action, GameEvent* ev);
+void ex_pack(Record* r, const Board* bb);
+void ex_unpack(Board* bb, const Record* r, const Board* start);
+bool ex_run(Board* start, const char* name, size_t mem_limit, const char* dir);
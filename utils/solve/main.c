@@ -0,0 +1,849 @@
+#define _DEFAULT_SOURCE
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+#include <unistd.h>
+#include "explore.h"
+
+#define DEFAULT_NODES (4u << 20)
+#define MAX_WORKERS 64
+#define MAILBOX 64
+#define NO_GOAL UINT64_MAX
+#define GEN_PAIRS 2
+#define GEN_ENERGY 2000
+#define DEFAULT_MEM_MIB 256
+#define BOMB_COST 3
+#define CLEAR_COST 4
+#define FAR UINT8_MAX
+
+typedef struct {
+    Record rec;
+    uint64_t key;
+    uint32_t parent;
+    uint8_t worker;
+    uint8_t action;
+    uint16_t g;
+} Node;
+
+typedef struct {
+    _Alignas(64) _Atomic uint32_t head;
+    _Alignas(64) _Atomic uint32_t tail;
+    Node msgs[MAILBOX];
+} Mailbox;
+
+typedef struct Search Search;
+
+typedef struct {
+    Search* s;
+    uint32_t id;
+    Node* nodes;
+    uint32_t n_nodes;
+    uint32_t cap_nodes;
+    uint32_t* table;
+    uint32_t mask;
+    uint64_t* open;
+    uint32_t n_open;
+    uint32_t cap_open;
+    uint64_t expanded;
+} Worker;
+
+struct Search {
+    uint32_t n_workers;
+    uint32_t max_nodes;
+    bool greedy;
+    Board start;
+    Deadlocks dl;
+    uint8_t dist[2][MAP_W * MAP_H][MAP_W * MAP_H];
+    Worker* workers;
+    Mailbox* boxes;
+    _Atomic uint64_t goal;
+    _Atomic int64_t outstanding;
+    _Atomic uint32_t stored;
+    atomic_bool aborted;
+};
+
+static const char ACTION_NAMES[ACTIONS] = { 'R', 'L', 'D', 'U', 'S' };
+
+static uint64_t zobrist[BB_CLASSES][MAP_W * MAP_H];
+
+static uint64_t splitmix(uint64_t* x);
+static void init_zobrist(void);
+static uint64_t mask_key(PieceClass c, Mask m);
+static uint64_t board_key(Board* bb);
+static uint64_t update_key(uint64_t key, Board* from, Board* to);
+static bool same_board(Record* a, Record* b);
+static bool has_cell(Mask m, int cell);
+static uint32_t list_cells(Mask m, uint8_t* out);
+static int next_cell(int cell, Delta d);
+static void init_distances(Search* s);
+static uint16_t estimate(Search* s, Board* bb);
+static int bomb_distance(Search* s, Board* bb, int from, Mask to);
+static uint16_t progress(Search* s, Board* bb);
+static uint32_t owner(Search* s, uint64_t key);
+static uint32_t goal_cost(Search* s);
+static void grow_table(Worker* w);
+static bool store(Worker* w, Node* n, uint32_t* index);
+static bool insert(Worker* w, Node* n);
+static void push_open(Worker* w, uint16_t f, uint16_t g, uint32_t node);
+static uint32_t pop_open(Worker* w);
+static bool post(Worker* w, uint32_t to, Node* n);
+static void drain(Worker* w);
+static void record_goal(Worker* w, Node* n);
+static void expand(Worker* w, uint32_t index);
+static void* work(void* arg);
+static int64_t solve(Search* s, Board* start);
+static uint32_t print_path(Search* s, uint32_t worker, uint32_t node);
+static bool load_level(Board* bb, Deadlocks* dl, int32_t level);
+static bool load_file(Board* bb, const char* path);
+static void generate(Board* bb, uint64_t seed);
+static double now(void);
+static double run(Board* start, const Deadlocks* dl, const char* name, uint32_t max_nodes, uint32_t n_workers,
+                  bool greedy, bool quiet, int* failed);
+static void bench(Board* start, const Deadlocks* dl, const char* name, uint32_t max_nodes, uint32_t n_workers,
+                  bool greedy, int* failed);
+
+static uint64_t splitmix(uint64_t* x) {
+    uint64_t z = (*x += 0x9e3779b97f4a7c15u);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9u;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebu;
+    return z ^ (z >> 31);
+}
+
+static void init_zobrist(void) {
+    uint64_t x = 0x9e3779b97f4a7c15u;
+
+    for (int c = 0; c < BB_CLASSES; c++) {
+        for (int i = 0; i < MAP_W * MAP_H; i++) {
+            zobrist[c][i] = splitmix(&x);
+        }
+    }
+}
+
+static uint64_t mask_key(PieceClass c, Mask m) {
+    uint64_t key = 0;
+
+    for (uint64_t w = m.lo; w != 0; w &= w - 1) {
+        key ^= zobrist[c][__builtin_ctzll(w)];
+    }
+
+    for (uint64_t w = m.hi; w != 0; w &= w - 1) {
+        key ^= zobrist[c][64 + __builtin_ctzll(w)];
+    }
+
+    return key;
+}
+
+static uint64_t board_key(Board* bb) {
+    uint64_t key = 0;
+
+    for (int c = BB_BLOB_B; c < BB_CLASSES; c++) {
+        key ^= mask_key((PieceClass) c, bb->pcs[c]);
+    }
+
+    return key;
+}
+
+static uint64_t update_key(uint64_t key, Board* from, Board* to) {
+    for (int c = BB_BLOB_B; c < BB_CLASSES; c++) {
+        Mask diff = { from->pcs[c].lo ^ to->pcs[c].lo, from->pcs[c].hi ^ to->pcs[c].hi };
+        key ^= mask_key((PieceClass) c, diff);
+    }
+
+    return key;
+}
+
+static bool same_board(Record* a, Record* b) {
+    return memcmp(a->pcs, b->pcs, sizeof(a->pcs)) == 0;
+}
+
+static bool has_cell(Mask m, int cell) {
+    return (cell < 64 ? m.lo >> cell : m.hi >> (cell - 64)) & 1;
+}
+
+static uint32_t list_cells(Mask m, uint8_t* out) {
+    uint32_t n = 0;
+
+    for (uint64_t w = m.lo; w != 0; w &= w - 1) {
+        out[n++] = (uint8_t) __builtin_ctzll(w);
+    }
+
+    for (uint64_t w = m.hi; w != 0; w &= w - 1) {
+        out[n++] = (uint8_t) (64 + __builtin_ctzll(w));
+    }
+
+    return n;
+}
+
+static int next_cell(int cell, Delta d) {
+    int row = (cell / MAP_W + d.y + MAP_H) % MAP_H;
+    int col = (cell % MAP_W + d.x + MAP_W) % MAP_W;
+    return row * MAP_W + col;
+}
+
+static void init_distances(Search* s) {
+    Mask walls = s->start.pcs[BB_WALL];
+    memset(s->dist, FAR, sizeof(s->dist));
+
+    for (int g = 0; g < 2; g++) {
+        for (int src = 0; src < MAP_W * MAP_H; src++) {
+            uint8_t* dist = s->dist[g][src];
+            uint8_t queue[MAP_W * MAP_H];
+            uint32_t head = 0;
+            uint32_t tail = 0;
+
+            if (has_cell(walls, src)) {
+                continue;
+            }
+
+            dist[src] = 0;
+            queue[tail++] = (uint8_t) src;
+
+            while (head < tail) {
+                int cell = queue[head++];
+
+                for (int i = 0; i < 4; i++) {
+                    int to = next_cell(cell, BB_DIRS[i]);
+                    bool pushed = !has_cell(walls, next_cell(cell, invert_delta(BB_DIRS[i])));
+                    bool pulled = !has_cell(walls, next_cell(to, BB_DIRS[i]));
+
+                    if (!has_cell(walls, to) && (g == 1 || pushed || pulled) && dist[to] == FAR) {
+                        dist[to] = (uint8_t) (dist[cell] + 1);
+                        queue[tail++] = (uint8_t) to;
+                    }
+                }
+            }
+        }
+    }
+}
+
+static uint16_t estimate(Search* s, Board* bb) {
+    uint8_t blobs[2][MAP_W * MAP_H];
+    uint8_t players[MAP_W * MAP_H];
+    uint32_t n_blobs[2] = { list_cells(bb->pcs[BB_BLOB_B], blobs[0]), list_cells(bb->pcs[BB_BLOB_R], blobs[1]) };
+    Mask pcs = { bb->pcs[BB_ANTI].lo | bb->pcs[BB_MATTER].lo, bb->pcs[BB_ANTI].hi | bb->pcs[BB_MATTER].hi };
+    uint32_t n_players = list_cells(pcs, players);
+    int pair = 0;
+    int reach = MAP_W * MAP_H;
+
+    for (int c = 0; c < 2; c++) {
+        for (uint32_t i = 0; i < n_blobs[c]; i++) {
+            int x = blobs[c][i];
+            bool stuck = has_cell(s->dl.stuck, x);
+            int best = MAP_W * MAP_H;
+
+            for (uint32_t j = 0; j < n_blobs[!c]; j++) {
+                int y = blobs[!c][j];
+                int d = s->dist[0][x][y];
+                int cost = stuck || has_cell(s->dl.stuck, y) ? d : (d + 1) / 2;
+                best = cost < best ? cost : best;
+            }
+
+            for (uint32_t j = 0; j < n_players; j++) {
+                int d = s->dist[1][players[j]][x];
+                reach = d < reach ? d : reach;
+            }
+
+            pair = best > pair ? best : pair;
+        }
+    }
+
+    // Admissible: a move shifts each piece by at most one edge of the symmetric dist[0] graph, so a blob and the
+    // partner it clears with close a gap of d in no fewer than (d + 1) / 2 moves, or d if either one is stuck.
+    // No blob moves before a player gets next to one, and a swap does not bring either player closer.
+    return (uint16_t) (pair > 0 ? pair + (reach > 1 ? reach - 1 : 0) : 0);
+}
+
+static int bomb_distance(Search* s, Board* bb, int from, Mask to) {
+    Mask bombs = { bb->pcs[BB_BOMB_B].lo | bb->pcs[BB_BOMB_R].lo, bb->pcs[BB_BOMB_B].hi | bb->pcs[BB_BOMB_R].hi };
+    uint8_t cost[MAP_W * MAP_H];
+    uint8_t queue[BOMB_COST + 2][MAP_W * MAP_H * 4];
+    uint32_t n[BOMB_COST + 2] = { 0 };
+    memset(cost, FAR, sizeof(cost));
+    cost[from] = 0;
+    queue[0][n[0]++] = (uint8_t) from;
+
+    for (int d = 0; d < FAR; d++) {
+        uint32_t b = (uint32_t) d % (BOMB_COST + 2);
+
+        for (uint32_t i = 0; i < n[b]; i++) {
+            int cell = queue[b][i];
+
+            if (cost[cell] != d) {
+                continue;
+            }
+
+            if (has_cell(to, cell)) {
+                return d;
+            }
+
+            for (int k = 0; k < 4; k++) {
+                int next = next_cell(cell, BB_DIRS[k]);
+                int c = d + 1 + (has_cell(bombs, next) ? BOMB_COST : 0);
+
+                if (s->dist[0][from][next] != FAR && c < cost[next]) {
+                    cost[next] = (uint8_t) c;
+                    queue[c % (BOMB_COST + 2)][n[c % (BOMB_COST + 2)]++] = (uint8_t) next;
+                }
+            }
+        }
+
+        n[b] = 0;
+    }
+
+    return FAR;
+}
+
+static uint16_t progress(Search* s, Board* bb) {
+    uint8_t blobs[MAP_W * MAP_H];
+    uint8_t players[MAP_W * MAP_H];
+    Mask pcs = { bb->pcs[BB_ANTI].lo | bb->pcs[BB_MATTER].lo, bb->pcs[BB_ANTI].hi | bb->pcs[BB_MATTER].hi };
+    uint32_t n_players = list_cells(pcs, players);
+    int sum = CLEAR_COST * bb->to_clear;
+    int reach = FAR;
+
+    for (int c = 0; c < 2; c++) {
+        uint32_t n_blobs = list_cells(bb->pcs[BB_BLOB_B + c], blobs);
+
+        for (uint32_t i = 0; i < n_blobs; i++) {
+            sum += bomb_distance(s, bb, blobs[i], bb->pcs[BB_BLOB_R - c]);
+
+            for (uint32_t j = 0; j < n_players; j++) {
+                int d = s->dist[1][players[j]][blobs[i]];
+                reach = d < reach ? d : reach;
+            }
+        }
+    }
+
+    return (uint16_t) (sum + (reach > 1 && reach < FAR ? reach - 1 : 0));
+}
+
+static uint32_t owner(Search* s, uint64_t key) {
+    return (uint32_t) ((key >> 32) % s->n_workers);
+}
+
+static uint32_t goal_cost(Search* s) {
+    return (uint32_t) (atomic_load_explicit(&s->goal, memory_order_relaxed) >> 40);
+}
+
+static void grow_table(Worker* w) {
+    uint32_t size = w->table != NULL ? (w->mask + 1) * 2 : 1u << 12;
+    uint32_t* table = calloc(size, sizeof(uint32_t));
+    assert(table != NULL);
+
+    for (uint32_t i = 0; w->table != NULL && i <= w->mask; i++) {
+        if (w->table[i] != 0) {
+            uint32_t j = (uint32_t) w->nodes[w->table[i]].key & (size - 1);
+
+            while (table[j] != 0) {
+                j = (j + 1) & (size - 1);
+            }
+
+            table[j] = w->table[i];
+        }
+    }
+
+    free(w->table);
+    w->table = table;
+    w->mask = size - 1;
+}
+
+static bool store(Worker* w, Node* n, uint32_t* index) {
+    if (atomic_fetch_add(&w->s->stored, 1) >= w->s->max_nodes) {
+        atomic_store(&w->s->aborted, true);
+        return false;
+    }
+
+    if (w->n_nodes == w->cap_nodes) {
+        w->cap_nodes *= 2;
+        w->nodes = realloc(w->nodes, (size_t) w->cap_nodes * sizeof(Node));
+        assert(w->nodes != NULL);
+    }
+
+    *index = w->n_nodes++;
+    w->nodes[*index] = *n;
+    return true;
+}
+
+static bool insert(Worker* w, Node* n) {
+    if ((uint64_t) w->n_nodes * 2 >= w->mask) {
+        grow_table(w);
+    }
+
+    uint32_t i = (uint32_t) n->key & w->mask;
+
+    while (w->table[i] != 0) {
+        Node* old = &w->nodes[w->table[i]];
+
+        if (old->key == n->key && same_board(&old->rec, &n->rec)) {
+            if (old->g <= n->g && old->rec.energy >= n->rec.energy) {
+                return false;
+            }
+
+            break;
+        }
+
+        i = (i + 1) & w->mask;
+    }
+
+    uint32_t index;
+    Board bb;
+    ex_unpack(&bb, &n->rec, &w->s->start);
+
+    if (!store(w, n, &index)) {
+        return false;
+    }
+
+    w->table[i] = index;
+    push_open(w, (uint16_t) (n->g + (w->s->greedy ? progress(w->s, &bb) : estimate(w->s, &bb))), n->g, index);
+    return true;
+}
+
+static void push_open(Worker* w, uint16_t f, uint16_t g, uint32_t node) {
+    if (w->n_open == w->cap_open) {
+        w->cap_open *= 2;
+        w->open = realloc(w->open, (size_t) w->cap_open * sizeof(uint64_t));
+        assert(w->open != NULL);
+    }
+
+    uint64_t e = (uint64_t) f << 48 | (uint64_t) (UINT16_MAX - g) << 32 | node;
+    uint32_t i = w->n_open++;
+
+    while (i > 0 && w->open[(i - 1) / 2] > e) {
+        w->open[i] = w->open[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+
+    w->open[i] = e;
+}
+
+static uint32_t pop_open(Worker* w) {
+    uint64_t top = w->open[0];
+    uint64_t e = w->open[--w->n_open];
+    uint32_t i = 0;
+
+    for (uint32_t c = 1; c < w->n_open; c = 2 * i + 1) {
+        c += c + 1 < w->n_open && w->open[c + 1] < w->open[c];
+
+        if (e <= w->open[c]) {
+            break;
+        }
+
+        w->open[i] = w->open[c];
+        i = c;
+    }
+
+    w->open[i] = e;
+    return (uint32_t) top;
+}
+
+static bool post(Worker* w, uint32_t to, Node* n) {
+    Mailbox* box = &w->s->boxes[w->id * w->s->n_workers + to];
+    uint32_t tail = atomic_load_explicit(&box->tail, memory_order_relaxed);
+
+    while (tail - atomic_load_explicit(&box->head, memory_order_acquire) == MAILBOX) {
+        if (atomic_load_explicit(&w->s->aborted, memory_order_relaxed)) {
+            return false;
+        }
+
+        drain(w);
+        sched_yield();
+    }
+
+    box->msgs[tail % MAILBOX] = *n;
+    atomic_store_explicit(&box->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+static void drain(Worker* w) {
+    Search* s = w->s;
+
+    for (uint32_t from = 0; from < s->n_workers; from++) {
+        Mailbox* box = &s->boxes[from * s->n_workers + w->id];
+        uint32_t head = atomic_load_explicit(&box->head, memory_order_relaxed);
+        uint32_t tail = atomic_load_explicit(&box->tail, memory_order_acquire);
+
+        for (; head != tail; head++) {
+            if (!insert(w, &box->msgs[head % MAILBOX])) {
+                atomic_fetch_sub(&s->outstanding, 1);
+            }
+        }
+
+        atomic_store_explicit(&box->head, head, memory_order_release);
+    }
+}
+
+static void record_goal(Worker* w, Node* n) {
+    uint32_t index;
+
+    if (!store(w, n, &index)) {
+        return;
+    }
+
+    uint64_t goal = (uint64_t) n->g << 40 | (uint64_t) w->id << 32 | index;
+    uint64_t best = atomic_load(&w->s->goal);
+
+    while (goal < best && !atomic_compare_exchange_weak(&w->s->goal, &best, goal)) {
+    }
+}
+
+static void expand(Worker* w, uint32_t index) {
+    Search* s = w->s;
+    w->expanded++;
+
+    Board from;
+    ex_unpack(&from, &w->nodes[index].rec, &s->start);
+
+    for (uint8_t a = 0; a < ACTIONS; a++) {
+        Node* parent = &w->nodes[index];
+        Node n = { .parent = index, .worker = (uint8_t) w->id, .action = a, .g = (uint16_t) (parent->g + 1) };
+        Board bb = from;
+        GameEvent ev;
+
+        if (!ex_apply(&bb, a, &ev) || ev == GE_EXPLODE || ev == GE_EXHAUSTED) {
+            continue;
+        }
+
+        ex_pack(&n.rec, &bb);
+        n.key = update_key(parent->key, &from, &bb);
+
+        if (ev == GE_CLEAR) {
+            record_goal(w, &n);
+            continue;
+        }
+
+        if ((ev == GE_DESTROY && bb_deadlocked(&s->dl, &bb)) || n.g + estimate(s, &bb) >= goal_cost(s)) {
+            continue;
+        }
+
+        uint32_t to = owner(s, n.key);
+        atomic_fetch_add(&s->outstanding, 1);
+
+        if (to == w->id ? !insert(w, &n) : !post(w, to, &n)) {
+            atomic_fetch_sub(&s->outstanding, 1);
+        }
+    }
+}
+
+static void* work(void* arg) {
+    Worker* w = arg;
+    Search* s = w->s;
+
+    while (!atomic_load_explicit(&s->aborted, memory_order_relaxed)) {
+        drain(w);
+
+        if (w->n_open == 0) {
+            if (atomic_load(&s->outstanding) == 0) {
+                break;
+            }
+
+            sched_yield();
+        } else if (w->open[0] >> 48 >= goal_cost(s) || (s->greedy && atomic_load(&s->goal) != NO_GOAL)) {
+            atomic_fetch_sub(&s->outstanding, w->n_open);
+            w->n_open = 0;
+        } else {
+            expand(w, pop_open(w));
+            atomic_fetch_sub(&s->outstanding, 1);
+        }
+    }
+
+    return NULL;
+}
+
+static int64_t solve(Search* s, Board* start) {
+    s->workers = calloc(s->n_workers, sizeof(Worker));
+    s->boxes = calloc((size_t) s->n_workers * s->n_workers, sizeof(Mailbox));
+    assert(s->workers != NULL && s->boxes != NULL);
+    atomic_init(&s->goal, NO_GOAL);
+    atomic_init(&s->outstanding, 1);
+    atomic_init(&s->stored, 0);
+    atomic_init(&s->aborted, false);
+
+    for (uint32_t i = 0; i < s->n_workers; i++) {
+        Worker* w = &s->workers[i];
+        *w = (Worker) { .s = s, .id = i, .n_nodes = 1, .cap_nodes = 1024, .cap_open = 1024 };
+        w->nodes = malloc(w->cap_nodes * sizeof(Node));
+        w->open = malloc(w->cap_open * sizeof(uint64_t));
+        assert(w->nodes != NULL && w->open != NULL);
+        grow_table(w);
+    }
+
+    Node root = { .key = board_key(start) };
+    ex_pack(&root.rec, start);
+    insert(&s->workers[owner(s, root.key)], &root);
+    pthread_t threads[MAX_WORKERS];
+    uint32_t started = 1;
+
+    for (; started < s->n_workers; started++) {
+        if (pthread_create(&threads[started], NULL, work, &s->workers[started]) != 0) {
+            fprintf(stderr, "cannot start worker thread\n");
+            atomic_store(&s->aborted, true);
+            break;
+        }
+    }
+
+    work(&s->workers[0]);
+
+    for (uint32_t i = 1; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    return atomic_load(&s->goal) == NO_GOAL ? -1 : (int64_t) (atomic_load(&s->goal) & 0xffffffffffu);
+}
+
+static uint32_t print_path(Search* s, uint32_t worker, uint32_t node) {
+    Node* n = &s->workers[worker].nodes[node];
+
+    if (n->g == 0) {
+        return 0;
+    }
+
+    uint32_t depth = print_path(s, n->worker, n->parent);
+    putchar(ACTION_NAMES[n->action]);
+    return depth + 1;
+}
+
+static bool load_level(Board* bb, Deadlocks* dl, int32_t level) {
+    if (level < 0 || level >= MAX_LEVEL) {
+        return false;
+    }
+
+    GameState* gs = gs_init(0.0);
+    assert(gs != NULL);
+    gs->level = level;
+    gs_load_level(gs);
+    bb_load(bb, gs);
+    bb_unpack_deadlocks(dl, gs_level_state(level)->regions);
+    gs_quit(gs);
+    return true;
+}
+
+static bool load_file(Board* bb, const char* path) {
+    FILE* file = fopen(path, "r");
+
+    if (file == NULL) {
+        return false;
+    }
+
+    *bb = (Board) { 0 };
+    unsigned id;
+    int i = 0;
+
+    while (i < MAP_W * MAP_H && fscanf(file, " %u ,", &id) == 1) {
+        Mask m = i < 64 ? (Mask) { 1ull << i, 0 } : (Mask) { 0, 1ull << (i - 64) };
+        int c = id == ID_ANTI ? BB_ANTI : id == ID_MATTER ? BB_MATTER :
+            id == ID_BLOB_B ? BB_BLOB_B : id == ID_BLOB_R ? BB_BLOB_R :
+            id == ID_BOMB_B ? BB_BOMB_B : id == ID_BOMB_R ? BB_BOMB_R :
+            id >= WALL_TILE_BASE ? BB_WALL : -1;
+
+        if (c >= 0) {
+            bb->pcs[c].lo |= m.lo;
+            bb->pcs[c].hi |= m.hi;
+            bb->to_clear += c == BB_BLOB_B || c == BB_BLOB_R;
+        }
+
+        i++;
+    }
+
+    bool ok = i == MAP_W * MAP_H && fscanf(file, " %d", &bb->energy) == 1;
+    fclose(file);
+    return ok;
+}
+
+static void generate(Board* bb, uint64_t seed) {
+    static const PieceClass PIECES[] = { BB_ANTI, BB_MATTER, BB_BOMB_B, BB_BOMB_R };
+    *bb = (Board) { .energy = GEN_ENERGY, .to_clear = 2 * GEN_PAIRS };
+    uint8_t cells[MAP_W * MAP_H];
+    uint32_t n = MAP_W * MAP_H;
+
+    for (uint32_t i = 0; i < n; i++) {
+        cells[i] = (uint8_t) i;
+    }
+
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t j = i + (uint32_t) (splitmix(&seed) % (n - i));
+        uint8_t t = cells[i];
+        cells[i] = cells[j];
+        cells[j] = t;
+    }
+
+    for (uint32_t i = 0; i < n; i++) {
+        Mask m = cells[i] < 64 ? (Mask) { 1ull << cells[i], 0 } : (Mask) { 0, 1ull << (cells[i] - 64) };
+        PieceClass c = i < 4 ? PIECES[i] : i < 4 + 2 * GEN_PAIRS ? BB_BLOB_B + i % 2 :
+            i < n / 5 ? BB_WALL : BB_CLASSES;
+
+        if (c != BB_CLASSES) {
+            bb->pcs[c].lo |= m.lo;
+            bb->pcs[c].hi |= m.hi;
+        }
+    }
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double run(Board* start, const Deadlocks* dl, const char* name, uint32_t max_nodes, uint32_t n_workers,
+                  bool greedy, bool quiet, int* failed) {
+    Search s = { .n_workers = n_workers, .max_nodes = max_nodes, .greedy = greedy, .start = *start, .dl = *dl };
+    init_distances(&s);
+
+    if (bb_deadlocked(&s.dl, start)) {
+        printf("%s: no solution (blobs cannot pair up)\n", name);
+        *failed = 1;
+        return 0.0;
+    }
+
+    double t0 = now();
+    int64_t goal = solve(&s, start);
+    double secs = now() - t0;
+    uint64_t expanded = 0;
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+
+    for (uint32_t i = 0; i < n_workers; i++) {
+        expanded += s.workers[i].expanded;
+    }
+
+    if (!quiet) {
+        uint32_t moves = 0;
+        printf("%s: ", name);
+
+        if (goal < 0) {
+            printf("no solution");
+        } else {
+            moves = print_path(&s, (uint32_t) (atomic_load(&s.goal) >> 32 & 0xff), (uint32_t) goal);
+        }
+
+        printf(" (%u moves%s, %llu expanded, %.0f nodes/s, %u stored, %u threads, peak %ld KiB)\n",
+               moves, goal >= 0 && !greedy ? ", optimal" : "", (unsigned long long) expanded, secs > 0 ? (double) expanded / secs : 0.0,
+               s.stored < max_nodes ? (uint32_t) s.stored : max_nodes, n_workers, (long) ru.ru_maxrss);
+    }
+
+    if (atomic_load(&s.aborted)) {
+        printf("%s: node limit reached%s\n", name, greedy ? "" : ", -g finds a non-optimal solution faster");
+    }
+
+    *failed |= goal < 0 || atomic_load(&s.aborted);
+
+    for (uint32_t i = 0; i < n_workers; i++) {
+        free(s.workers[i].nodes);
+        free(s.workers[i].table);
+        free(s.workers[i].open);
+    }
+
+    free(s.workers);
+    free(s.boxes);
+    return secs;
+}
+
+static void bench(Board* start, const Deadlocks* dl, const char* name, uint32_t max_nodes, uint32_t n_workers,
+                  bool greedy, int* failed) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    double base = run(start, dl, name, max_nodes, 1, greedy, false, failed);
+    printf("%s: 1 thread %.3fs", name, base);
+
+    for (uint32_t i = 2; i <= n_workers && i <= cpus; i++) {
+        double secs = run(start, dl, name, max_nodes, i, greedy, true, failed);
+        printf(", %u threads %.3fs %.2fx", i, secs, secs > 0 ? base / secs : 0.0);
+    }
+
+    if (n_workers > cpus) {
+        printf(" (%ld CPUs online, larger thread counts skipped)", cpus);
+    }
+
+    printf("\n");
+}
+
+int main(int argc, char** argv) {
+    uint32_t max_nodes = DEFAULT_NODES;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t n_workers = cpus < 1 ? 1 : cpus > MAX_WORKERS ? MAX_WORKERS : (uint32_t) cpus;
+    size_t mem_limit = (size_t) DEFAULT_MEM_MIB << 20;
+    const char* dir = getenv("TMPDIR") != NULL ? getenv("TMPDIR") : "/tmp";
+    bool speedup = false;
+    bool exhaustive = false;
+    bool greedy = false;
+    bool usage = false;
+    int failed = 0;
+    int opt;
+    init_zobrist();
+
+    while ((opt = getopt(argc, argv, "bd:gj:m:M:x")) != -1) {
+        if (opt == 'b') {
+            speedup = true;
+        } else if (opt == 'd') {
+            dir = optarg;
+        } else if (opt == 'g') {
+            greedy = true;
+        } else if (opt == 'j') {
+            n_workers = (uint32_t) strtoul(optarg, NULL, 10);
+        } else if (opt == 'm') {
+            max_nodes = (uint32_t) strtoul(optarg, NULL, 10);
+        } else if (opt == 'M') {
+            mem_limit = (size_t) strtoul(optarg, NULL, 10) << 20;
+        } else if (opt == 'x') {
+            exhaustive = true;
+        } else {
+            usage = true;
+            break;
+        }
+    }
+
+    if (usage || optind >= argc || max_nodes < 2 || n_workers < 1 || n_workers > MAX_WORKERS) {
+        fprintf(stderr, "usage: antimatter-solve [-b] [-g] [-j threads] [-m max_nodes] [-x [-M mem_mib] [-d dir]] "
+                "<level|all|gen:seed|level file>...\n"
+                "  -g  greedy best-first instead of optimal A*; levels 2, 4, 5 and 6 exceed the default node limit\n"
+                "      without it\n");
+        return 2;
+    }
+
+    for (int i = optind; i < argc; i++) {
+        Board start;
+        Deadlocks dl;
+        char name[32];
+        char* end;
+        long level = strtol(argv[i], &end, 10);
+        int32_t first = 0;
+        int32_t last = -1;
+
+        if (strcmp(argv[i], "all") == 0) {
+            last = MAX_LEVEL - 1;
+        } else if (*end == '\0' && level >= 0 && level < MAX_LEVEL) {
+            first = last = (int32_t) level;
+        } else if (strncmp(argv[i], "gen:", 4) == 0) {
+            generate(&start, strtoull(argv[i] + 4, NULL, 10));
+        } else if (!load_file(&start, argv[i])) {
+            fprintf(stderr, "cannot load level %s\n", argv[i]);
+            failed = 1;
+            continue;
+        }
+
+        for (int32_t l = first; l <= (last < 0 ? 0 : last); l++) {
+            if (last >= 0) {
+                snprintf(name, sizeof(name), "level %d", l);
+                load_level(&start, &dl, l);
+            } else {
+                snprintf(name, sizeof(name), "%.31s", argv[i]);
+                bb_deadlocks(&dl, &start);
+            }
+
+            if (exhaustive) {
+                failed |= !ex_run(&start, name, mem_limit, dir);
+            } else if (speedup) {
+                bench(&start, &dl, name, max_nodes, n_workers, greedy, &failed);
+            } else {
+                run(&start, &dl, name, max_nodes, n_workers, greedy, false, &failed);
+            }
+        }
+    }
+
+    return failed;
+}
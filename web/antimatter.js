@@ -5,6 +5,8 @@ class WasmGame {
         this.height = height;
         this.events = [];
         this.touches = {};
+        this.hashLog = new URLSearchParams(location.search).has("hashlog") ? [] : null;
+        this.resume = new URLSearchParams(location.search).has("resume");
     }
 
     eventVariants = {
@@ -21,6 +23,8 @@ class WasmGame {
         "F5": 12,
         "F6": 13,
         "F10": 14,
+        "F7": 15,
+        "F8": 16,
     };
 
     palette = [
@@ -79,6 +83,30 @@ class WasmGame {
             wbe_send_audiomsg: (msg) => {
                 this.audio.sendMessage(msg);
             },
+            wbe_record_hash: (tick, hi, lo) => {
+                if (this.hashLog) {
+                    const hex = n => (n >>> 0).toString(16).padStart(8, "0");
+                    this.hashLog.push(`${tick} ${hex(hi)}${hex(lo)}\n`);
+                }
+            },
+            wbe_save_state: (ptr, len) => {
+                if (this.resume) {
+                    const buf = new Uint8Array(this.exports.memory.buffer, ptr, len);
+                    localStorage.setItem(`${this.name}.state`, btoa(String.fromCharCode(...buf)));
+                }
+            },
+            wbe_load_state: (ptr, cap) => {
+                const data = this.resume ? localStorage.getItem(`${this.name}.state`) : null;
+
+                if (!data) {
+                    return 0;
+                }
+
+                const bytes = Uint8Array.from(atob(data), c => c.charCodeAt(0));
+                const len = Math.min(bytes.length, cap);
+                new Uint8Array(this.exports.memory.buffer, ptr, len).set(bytes.subarray(0, len));
+                return len;
+            },
         },
     };
 
@@ -131,6 +159,15 @@ class WasmGame {
         window.requestAnimationFrame(nextFrame);
     }
 
+    saveHashLog() {
+        const blob = new Blob(this.hashLog || [], { type: "text/plain" });
+        const a = document.createElement("a");
+        a.href = URL.createObjectURL(blob);
+        a.download = `${this.name}.hashes`;
+        a.click();
+        URL.revokeObjectURL(a.href);
+    }
+
     loadPixelData() {
         const structPtr = this.exports.wbe_load_pixel_data();
         if (!structPtr) throw new Error("null pixel data");
@@ -354,6 +391,11 @@ class AudioSubsystem {
 
 function chromeCompatibilityHack() {
     const game = new WasmGame("antimatter", 256, 192);
+
+    if (game.hashLog) {
+        window.saveHashLog = () => game.saveHashLog();
+    }
+
     let ctx = new AudioContext();
 
     setTimeout(() => {